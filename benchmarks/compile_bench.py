@@ -0,0 +1,190 @@
+#!/usr/bin/env python3
+"""Measure the compile-time cost of rstd++/result.hpp.
+
+For every configuration (N, M) a translation unit is generated with N
+distinct Result<T, E> instantiations, each driven through a chain of M
+combinators (map, and_then, map_err, or_else in turn). N = 0 measures the
+cost of parsing the headers alone.
+
+Each unit is compiled with the given compiler command and three things are
+recorded per configuration:
+
+  frontend_s       best wall time of -fsyntax-only over --repeat runs
+  instantiations   template instantiations reported by clang -ftime-trace,
+                   or, for other compilers, the number of rstd symbols
+                   emitted into the -O0 object
+  object_bytes     size of the -O0 object file, with text_bytes next to it
+                   when binutils `size` is available
+
+Usage:
+  compile_bench.py --include include --out compile.json -- g++ -std=c++20
+"""
+
+import argparse
+import json
+import os
+import shutil
+import subprocess
+import sys
+import tempfile
+import time
+
+COMBINATORS = [
+    '.map([](V{n} v) {{ return V{n}{{v.value + {m}}}; }})',
+    '.and_then([](V{n} v) {{ return R{n}::Ok(V{n}{{v.value * {m}}}); }})',
+    '.map_err([](E{n} e) {{ return E{n}{{e.code + {m}}}; }})',
+    '.or_else([](E{n} e) {{ return R{n}::Err(E{n}{{e.code - {m}}}); }})',
+]
+
+
+def generate(n, m):
+    """Return the source of a unit with n instantiations and m combinators"""
+    lines = ['#include "rstd++/result.hpp"', '',
+             'using rstd::result::Result;', '']
+    for i in range(n):
+        chain = ''.join(COMBINATORS[j % len(COMBINATORS)].format(n=i, m=j)
+                        for j in range(m))
+        lines += [
+            f'struct V{i} {{ int value; }};',
+            f'struct E{i} {{ int code; }};',
+            f'using R{i} = Result<V{i}, E{i}>;',
+            f'auto make{i}(int x) -> R{i}',
+            '{',
+            f'    return x > {i} ? R{i}::Ok(V{i}{{x}}) : R{i}::Err(E{i}{{x}});',
+            '}',
+            f'auto run{i}(int x) -> int',
+            '{',
+            f'    auto r = make{i}(x){chain};',
+            '    return r.is_ok() ? r.unwrap_unchecked().value',
+            '                     : r.unwrap_err_unchecked().code;',
+            '}',
+            '',
+        ]
+    return '\n'.join(lines) + '\n'
+
+
+def is_clang(cxx):
+    out = subprocess.run(cxx + ['--version'], capture_output=True, text=True)
+    return 'clang' in out.stdout
+
+
+def compile_unit(cxx, args, check=True):
+    start = time.perf_counter()
+    proc = subprocess.run(cxx + args, capture_output=True, text=True)
+    elapsed = time.perf_counter() - start
+    if check and proc.returncode != 0:
+        sys.stderr.write(proc.stderr)
+        raise SystemExit(f'compilation failed: {" ".join(cxx + args)}')
+    return elapsed
+
+
+def count_clang_instantiations(trace_path):
+    with open(trace_path) as f:
+        events = json.load(f)['traceEvents']
+    return sum(1 for e in events
+               if e.get('name') in ('InstantiateClass', 'InstantiateFunction'))
+
+
+def count_rstd_symbols(obj):
+    nm = shutil.which('nm')
+    if nm is None:
+        return None
+    out = subprocess.run([nm, '-C', obj], capture_output=True, text=True)
+    return sum(1 for line in out.stdout.splitlines() if 'rstd::' in line)
+
+
+def text_bytes(obj):
+    size = shutil.which('size')
+    if size is None:
+        return None
+    out = subprocess.run([size, '-A', obj], capture_output=True, text=True)
+    return sum(int(line.split()[1]) for line in out.stdout.splitlines()
+               if line.startswith('.text'))
+
+
+def measure(cxx, include, workdir, n, m, repeat, clang):
+    src = os.path.join(workdir, f'unit_{n}_{m}.cpp')
+    obj = os.path.join(workdir, f'unit_{n}_{m}.o')
+    with open(src, 'w') as f:
+        f.write(generate(n, m))
+
+    common = ['-I', include, src]
+    frontend = min(compile_unit(cxx, common + ['-fsyntax-only'])
+                   for _ in range(repeat))
+
+    obj_args = common + ['-O0', '-c', '-o', obj]
+    if clang:
+        obj_args.append('-ftime-trace')
+    compile_unit(cxx, obj_args)
+
+    if clang:
+        instantiations = count_clang_instantiations(obj[:-2] + '.json')
+    else:
+        instantiations = count_rstd_symbols(obj)
+
+    return {
+        'instantiations_n': n,
+        'combinators_m': m,
+        'frontend_s': round(frontend, 4),
+        'instantiations': instantiations,
+        'object_bytes': os.path.getsize(obj),
+        'text_bytes': text_bytes(obj),
+    }
+
+
+def parse_list(s):
+    return [int(x) for x in s.split(',') if x]
+
+
+def main():
+    parser = argparse.ArgumentParser(
+        description=__doc__, formatter_class=argparse.RawTextHelpFormatter)
+    parser.add_argument('--include', required=True,
+                        help='directory containing rstd++/')
+    parser.add_argument('--n', type=parse_list, default=[0, 1, 16, 64],
+                        help='comma-separated instantiation counts')
+    parser.add_argument('--m', type=parse_list, default=[0, 4, 16],
+                        help='comma-separated chain lengths')
+    parser.add_argument('--repeat', type=int, default=3,
+                        help='runs per frontend timing; the best is kept')
+    parser.add_argument('--out', help='write the results as JSON here')
+    parser.add_argument('--keep', help='keep the generated units here')
+    parser.add_argument('cxx', nargs=argparse.REMAINDER,
+                        help='compiler command, after --')
+    args = parser.parse_args()
+
+    cxx = [a for a in args.cxx if a != '--']
+    if not cxx:
+        parser.error('no compiler command given')
+    clang = is_clang(cxx)
+
+    configs = [(0, 0)] + [(n, m) for n in args.n if n > 0 for m in args.m]
+    results = []
+    with tempfile.TemporaryDirectory() as tmp:
+        workdir = args.keep or tmp
+        os.makedirs(workdir, exist_ok=True)
+        print(f'{"N":>5} {"M":>4} {"frontend_s":>11} {"instantiations":>15}'
+              f' {"object_bytes":>13} {"text_bytes":>11}')
+        for n, m in configs:
+            r = measure(cxx, os.path.abspath(args.include), workdir, n, m,
+                        args.repeat, clang)
+            results.append(r)
+            print(f'{n:>5} {m:>4} {r["frontend_s"]:>11.4f}'
+                  f' {str(r["instantiations"]):>15}'
+                  f' {r["object_bytes"]:>13} {str(r["text_bytes"]):>11}',
+                  flush=True)
+
+    if args.out:
+        report = {
+            'compiler': cxx,
+            'instantiation_metric': ('clang -ftime-trace' if clang
+                                     else 'rstd symbols in -O0 object'),
+            'results': results,
+        }
+        with open(args.out, 'w') as f:
+            json.dump(report, f, indent=2)
+            f.write('\n')
+
+
+if __name__ == '__main__':
+    main()
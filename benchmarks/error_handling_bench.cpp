@@ -0,0 +1,311 @@
+/**
+ * @file error_handling_bench.cpp
+ * @brief Compare Result with exceptions, error codes and std::expected
+ *
+ * Every strategy runs the same pipeline: a chain of steps that each bump a
+ * payload and may fail. Failures follow a fixed pseudo-random pattern with
+ * the error rate given in percent, so the branch predictor cannot learn
+ * them. Two families are measured:
+ *  - BM_Return: one step, across payload sizes
+ *  - BM_Chain: map/and_then chains of increasing depth on a small payload
+ *
+ * Items per second counts steps, so throughput is comparable across chain
+ * depths. `meson test --benchmark` writes the numbers as JSON next to the
+ * executable; compare two runs with Google Benchmark's tools/compare.py.
+ */
+
+#include "rstd++/result.hpp"
+
+#include <array>
+#include <benchmark/benchmark.h>
+#include <cstddef>
+#include <cstdint>
+#include <vector>
+
+#if defined(__cpp_lib_expected)
+#include <expected>
+#endif
+
+using namespace rstd::result;
+
+namespace
+{
+
+enum class ErrCode : std::int32_t
+{
+    None = 0,
+    NotFound,
+    Timeout,
+};
+
+/**
+ * @brief Payload of N bytes; only the first word is read and bumped
+ */
+template <std::size_t N> struct Payload
+{
+    static_assert(N % sizeof(std::uint64_t) == 0);
+    std::array<std::uint64_t, N / sizeof(std::uint64_t)> words{};
+};
+
+template <std::size_t N> auto bump(const Payload<N> &in) -> Payload<N>
+{
+    Payload<N> out = in;
+    ++out.words[0];
+    return out;
+}
+
+template <std::size_t N> auto value_of(const Payload<N> &p) -> std::int64_t
+{
+    return static_cast<std::int64_t>(p.words[0]);
+}
+
+/**
+ * @brief Fixed failure pattern: entry i is 1 with probability rate %
+ */
+class FailurePattern
+{
+    static constexpr std::size_t size = 4096;
+    std::vector<std::uint8_t> fails_;
+
+public:
+    explicit FailurePattern(std::int64_t rate_percent) : fails_(size)
+    {
+        std::uint32_t x = 2463534242u;
+        for (auto &f : fails_) {
+            x ^= x << 13;
+            x ^= x >> 17;
+            x ^= x << 5;
+            f = static_cast<std::int64_t>(x % 100) < rate_percent ? 1 : 0;
+        }
+    }
+
+    /**
+     * @brief Flags for one run of the pipeline, starting at @p i
+     */
+    [[nodiscard]] auto at(std::size_t i) const -> const std::uint8_t *
+    {
+        return fails_.data() + (i % (size - 64));
+    }
+};
+
+struct ResultStrategy
+{
+    template <typename T>
+    [[gnu::noinline]] static auto step(const T &in, bool fail)
+        -> Result<T, ErrCode>
+    {
+        if (fail) {
+            return Result<T, ErrCode>::Err(ErrCode::Timeout);
+        }
+        return Result<T, ErrCode>::Ok(bump(in));
+    }
+
+    template <int Depth, typename T>
+    static auto chain(const T &in, const std::uint8_t *fails)
+        -> Result<T, ErrCode>
+    {
+        if constexpr (Depth == 1) {
+            return step(in, fails[0] != 0);
+        } else {
+            return chain<Depth - 1>(in, fails)
+                .map([](const T &v) { return bump(v); })
+                .and_then([fails](const T &v) {
+                    return step(v, fails[Depth - 1] != 0);
+                });
+        }
+    }
+
+    template <int Depth, typename T>
+    static auto run(const T &in, const std::uint8_t *fails) -> std::int64_t
+    {
+        auto r = chain<Depth>(in, fails);
+        if (r.is_ok()) {
+            return value_of(r.unwrap_unchecked());
+        }
+        return -static_cast<std::int64_t>(r.unwrap_err_unchecked());
+    }
+};
+
+struct ExceptionStrategy
+{
+    struct Failure
+    {
+        ErrCode code;
+    };
+
+    template <typename T>
+    [[gnu::noinline]] static auto step(const T &in, bool fail) -> T
+    {
+        if (fail) {
+            throw Failure{ErrCode::Timeout};
+        }
+        return bump(in);
+    }
+
+    template <int Depth, typename T>
+    static auto chain(const T &in, const std::uint8_t *fails) -> T
+    {
+        if constexpr (Depth == 1) {
+            return step(in, fails[0] != 0);
+        } else {
+            return step(bump(chain<Depth - 1>(in, fails)),
+                        fails[Depth - 1] != 0);
+        }
+    }
+
+    template <int Depth, typename T>
+    static auto run(const T &in, const std::uint8_t *fails) -> std::int64_t
+    {
+        try {
+            return value_of(chain<Depth>(in, fails));
+        } catch (const Failure &f) {
+            return -static_cast<std::int64_t>(f.code);
+        }
+    }
+};
+
+struct ErrorCodeStrategy
+{
+    template <typename T>
+    [[gnu::noinline]] static auto step(const T &in, bool fail, T &out)
+        -> ErrCode
+    {
+        if (fail) {
+            return ErrCode::Timeout;
+        }
+        out = bump(in);
+        return ErrCode::None;
+    }
+
+    template <int Depth, typename T>
+    static auto chain(const T &in, const std::uint8_t *fails, T &out)
+        -> ErrCode
+    {
+        if constexpr (Depth == 1) {
+            return step(in, fails[0] != 0, out);
+        } else {
+            T mid;
+            if (auto ec = chain<Depth - 1>(in, fails, mid);
+                ec != ErrCode::None) {
+                return ec;
+            }
+            return step(bump(mid), fails[Depth - 1] != 0, out);
+        }
+    }
+
+    template <int Depth, typename T>
+    static auto run(const T &in, const std::uint8_t *fails) -> std::int64_t
+    {
+        T out;
+        if (auto ec = chain<Depth>(in, fails, out); ec != ErrCode::None) {
+            return -static_cast<std::int64_t>(ec);
+        }
+        return value_of(out);
+    }
+};
+
+#if defined(__cpp_lib_expected)
+struct ExpectedStrategy
+{
+    template <typename T>
+    [[gnu::noinline]] static auto step(const T &in, bool fail)
+        -> std::expected<T, ErrCode>
+    {
+        if (fail) {
+            return std::unexpected(ErrCode::Timeout);
+        }
+        return bump(in);
+    }
+
+    template <int Depth, typename T>
+    static auto chain(const T &in, const std::uint8_t *fails)
+        -> std::expected<T, ErrCode>
+    {
+        if constexpr (Depth == 1) {
+            return step(in, fails[0] != 0);
+        } else {
+            auto prev = chain<Depth - 1>(in, fails);
+#if __cpp_lib_expected >= 202211L
+            return std::move(prev)
+                .transform([](const T &v) { return bump(v); })
+                .and_then([fails](const T &v) {
+                    return step(v, fails[Depth - 1] != 0);
+                });
+#else
+            // Monadic operations arrived in a later revision of <expected>
+            if (!prev.has_value()) {
+                return std::unexpected(prev.error());
+            }
+            return step(bump(*prev), fails[Depth - 1] != 0);
+#endif
+        }
+    }
+
+    template <int Depth, typename T>
+    static auto run(const T &in, const std::uint8_t *fails) -> std::int64_t
+    {
+        auto r = chain<Depth>(in, fails);
+        if (r.has_value()) {
+            return value_of(*r);
+        }
+        return -static_cast<std::int64_t>(r.error());
+    }
+};
+#endif
+
+template <typename Strategy, int Depth, std::size_t N>
+void run_pipeline(benchmark::State &state)
+{
+    const FailurePattern pattern(state.range(0));
+    const Payload<N> payload{};
+    std::int64_t sum = 0;
+    std::size_t i = 0;
+    for (auto _ : state) {
+        sum += Strategy::template run<Depth>(payload, pattern.at(i++));
+        benchmark::DoNotOptimize(sum);
+    }
+    state.SetItemsProcessed(state.iterations() * Depth);
+    state.counters["error_rate_pct"] = static_cast<double>(state.range(0));
+    state.counters["payload_bytes"] = static_cast<double>(N);
+    state.counters["depth"] = Depth;
+}
+
+template <typename Strategy, std::size_t N>
+void BM_Return(benchmark::State &state)
+{
+    run_pipeline<Strategy, 1, N>(state);
+}
+
+template <typename Strategy, int Depth>
+void BM_Chain(benchmark::State &state)
+{
+    run_pipeline<Strategy, Depth, 8>(state);
+}
+
+/**
+ * @brief Error rates in percent
+ */
+void error_rates(benchmark::internal::Benchmark *b)
+{
+    for (int rate : {0, 1, 10, 50}) {
+        b->Arg(rate);
+    }
+}
+
+} // namespace
+
+#define RSTD_BENCH_STRATEGY(S)                                                 \
+    BENCHMARK_TEMPLATE(BM_Return, S, 8)->Apply(error_rates);                   \
+    BENCHMARK_TEMPLATE(BM_Return, S, 64)->Apply(error_rates);                  \
+    BENCHMARK_TEMPLATE(BM_Return, S, 256)->Apply(error_rates);                 \
+    BENCHMARK_TEMPLATE(BM_Chain, S, 4)->Apply(error_rates);                    \
+    BENCHMARK_TEMPLATE(BM_Chain, S, 16)->Apply(error_rates)
+
+RSTD_BENCH_STRATEGY(ResultStrategy);
+RSTD_BENCH_STRATEGY(ExceptionStrategy);
+RSTD_BENCH_STRATEGY(ErrorCodeStrategy);
+#if defined(__cpp_lib_expected)
+RSTD_BENCH_STRATEGY(ExpectedStrategy);
+#endif
+
+BENCHMARK_MAIN();
@@ -0,0 +1,193 @@
+/**
+ * @file expected_bench.cpp
+ * @brief Compare Result with C++23 std::expected on the same workloads
+ *
+ * Every workload is written once against a small adapter and instantiated
+ * for both types. The produce_*() and chain_*() functions are never
+ * inlined, so their code can be diffed with
+ * `objdump -dC --no-show-raw-insn expected_bench`.
+ */
+
+#include "rstd++/result.hpp"
+
+#include <benchmark/benchmark.h>
+#include <cstdint>
+#include <string>
+
+#if defined(__cpp_lib_expected)
+
+#include <expected>
+
+using namespace rstd::result;
+
+namespace
+{
+
+enum class ErrCode : std::int32_t
+{
+    NotFound = 1,
+    Timeout,
+};
+
+template <typename T, typename E> struct ResultApi
+{
+    using type = Result<T, E>;
+
+    static auto ok(T v) -> type { return type::Ok(std::move(v)); }
+    static auto err(E e) -> type { return type::Err(std::move(e)); }
+    static auto is_ok(const type &r) -> bool { return r.is_ok(); }
+    static auto take(type &&r) -> T
+    {
+        return std::move(r).unwrap_unchecked();
+    }
+
+    template <typename Fn> static auto and_then(type &&r, Fn &&fn) -> type
+    {
+        return std::move(r).and_then(std::forward<Fn>(fn));
+    }
+};
+
+template <typename T, typename E> struct ExpectedApi
+{
+    using type = std::expected<T, E>;
+
+    static auto ok(T v) -> type { return type(std::move(v)); }
+    static auto err(E e) -> type { return type(std::unexpect, std::move(e)); }
+    static auto is_ok(const type &r) -> bool { return r.has_value(); }
+    static auto take(type &&r) -> T { return *std::move(r); }
+
+    template <typename Fn> static auto and_then(type &&r, Fn &&fn) -> type
+    {
+#if __cpp_lib_expected >= 202211L
+        return std::move(r).and_then(std::forward<Fn>(fn));
+#else
+        // Monadic operations arrived in a later revision of <expected>
+        if (r.has_value()) {
+            return std::forward<Fn>(fn)(*std::move(r));
+        }
+        return type(std::unexpect, std::move(r).error());
+#endif
+    }
+};
+
+template <template <typename, typename> class Api, typename T>
+[[gnu::noinline]] auto produce(std::int32_t i, T payload)
+    -> typename Api<T, ErrCode>::type
+{
+    if ((i & 15) == 0) {
+        return Api<T, ErrCode>::err(ErrCode::Timeout);
+    }
+    return Api<T, ErrCode>::ok(std::move(payload));
+}
+
+template <template <typename, typename> class Api>
+[[gnu::noinline]] auto chain(std::int64_t v, std::int64_t fail_every)
+    -> typename Api<std::int64_t, ErrCode>::type
+{
+    using A = Api<std::int64_t, ErrCode>;
+    auto step = [fail_every](std::int64_t x) {
+        if (fail_every != 0 && x % fail_every == 0) {
+            return A::err(ErrCode::NotFound);
+        }
+        return A::ok(x + 1);
+    };
+    return A::and_then(A::and_then(step(v), step), step);
+}
+
+template <template <typename, typename> class Api>
+void BM_ReturnInt(benchmark::State &state)
+{
+    using A = Api<std::int32_t, ErrCode>;
+    std::int64_t sum = 0;
+    std::int32_t i = 0;
+    for (auto _ : state) {
+        auto r = produce<Api>(i, i);
+        sum += A::is_ok(r) ? A::take(std::move(r)) : -1;
+        benchmark::DoNotOptimize(sum);
+        ++i;
+    }
+    state.counters["sizeof"] = sizeof(typename A::type);
+}
+
+template <template <typename, typename> class Api>
+void BM_ReturnString(benchmark::State &state)
+{
+    using A = Api<std::string, ErrCode>;
+    const std::string payload(static_cast<std::size_t>(state.range(0)), 'x');
+    std::size_t sum = 0;
+    std::int32_t i = 0;
+    for (auto _ : state) {
+        auto r = produce<Api>(i++, payload);
+        if (A::is_ok(r)) {
+            sum += A::take(std::move(r)).size();
+        }
+        benchmark::DoNotOptimize(sum);
+    }
+    state.counters["sizeof"] = sizeof(typename A::type);
+}
+
+template <template <typename, typename> class Api>
+void BM_AndThenChain(benchmark::State &state)
+{
+    using A = Api<std::int64_t, ErrCode>;
+    const std::int64_t fail_every = state.range(0);
+    std::int64_t i = 1;
+    std::int64_t sum = 0;
+    for (auto _ : state) {
+        auto r = chain<Api>(i++, fail_every);
+        if (A::is_ok(r)) {
+            sum += A::take(std::move(r));
+        }
+        benchmark::DoNotOptimize(sum);
+    }
+}
+
+/**
+ * @brief Cross the boundary through into_expected()
+ */
+void BM_BoundaryIntoExpected(benchmark::State &state)
+{
+    const std::string payload(64, 'x');
+    std::size_t sum = 0;
+    std::int32_t i = 1;
+    for (auto _ : state) {
+        std::expected<std::string, ErrCode> ex =
+            produce<ResultApi>(i++, payload).into_expected();
+        sum += ex.has_value() ? ex->size() : 0;
+        benchmark::DoNotOptimize(sum);
+    }
+}
+
+/**
+ * @brief Cross the boundary through the ok()/err() Options
+ */
+void BM_BoundaryOptionals(benchmark::State &state)
+{
+    const std::string payload(64, 'x');
+    std::size_t sum = 0;
+    std::int32_t i = 1;
+    for (auto _ : state) {
+        const auto r = produce<ResultApi>(i++, payload);
+        std::expected<std::string, ErrCode> ex =
+            r.is_ok() ? std::expected<std::string, ErrCode>(*r.ok())
+                      : std::unexpected(*r.err());
+        sum += ex.has_value() ? ex->size() : 0;
+        benchmark::DoNotOptimize(sum);
+    }
+}
+
+} // namespace
+
+BENCHMARK_TEMPLATE(BM_ReturnInt, ResultApi);
+BENCHMARK_TEMPLATE(BM_ReturnInt, ExpectedApi);
+BENCHMARK_TEMPLATE(BM_ReturnString, ResultApi)->Arg(8)->Arg(64);
+BENCHMARK_TEMPLATE(BM_ReturnString, ExpectedApi)->Arg(8)->Arg(64);
+// Argument: one step in N fails (0 = never)
+BENCHMARK_TEMPLATE(BM_AndThenChain, ResultApi)->Arg(0)->Arg(2)->Arg(16);
+BENCHMARK_TEMPLATE(BM_AndThenChain, ExpectedApi)->Arg(0)->Arg(2)->Arg(16);
+BENCHMARK(BM_BoundaryIntoExpected);
+BENCHMARK(BM_BoundaryOptionals);
+
+#endif
+
+BENCHMARK_MAIN();
@@ -0,0 +1,136 @@
+/**
+ * @file par_bench.cpp
+ * @brief Scaling of the parallel fail-fast algorithms from 1 to N threads
+ *
+ * Each benchmark validates a batch of records with a function returning a
+ * Result. The argument is the number of threads in the pool, doubling from
+ * one up to the hardware concurrency, so the times show the speedup over
+ * the single-threaded run. BM_FailEarly puts one bad record near the
+ * start to show how quickly the other threads stop.
+ */
+
+#include "rstd++/par.hpp"
+#include "rstd++/result.hpp"
+
+#include <algorithm>
+#include <benchmark/benchmark.h>
+#include <cstdint>
+#include <functional>
+#include <thread>
+#include <vector>
+
+using namespace rstd::result;
+
+namespace
+{
+
+enum class ErrCode : std::int32_t
+{
+    BadChecksum = 1,
+};
+
+constexpr std::size_t record_count = 1 << 20;
+
+/**
+ * @brief Records with a checksum; the record at @p bad_index is corrupt
+ */
+auto make_records(std::size_t bad_index) -> std::vector<std::uint64_t>
+{
+    std::vector<std::uint64_t> records(record_count);
+    for (std::size_t i = 0; i < records.size(); ++i) {
+        records[i] = (i << 8) | ((i * 31) & 0xff);
+    }
+    if (bad_index < records.size()) {
+        records[bad_index] ^= 1;
+    }
+    return records;
+}
+
+/**
+ * @brief A few hundred cycles of work per record, then the checksum test
+ */
+auto validate(std::uint64_t record) -> Result<std::uint32_t, ErrCode>
+{
+    std::uint64_t h = record;
+    for (int round = 0; round < 32; ++round) {
+        h ^= h >> 33;
+        h *= 0xff51afd7ed558ccdULL;
+    }
+    benchmark::DoNotOptimize(h);
+    const std::uint64_t id = record >> 8;
+    if ((record & 0xff) != ((id * 31) & 0xff)) {
+        return Result<std::uint32_t, ErrCode>::Err(ErrCode::BadChecksum);
+    }
+    return Result<std::uint32_t, ErrCode>::Ok(
+        static_cast<std::uint32_t>(h));
+}
+
+auto validate_only(std::uint64_t record) -> Result<void, ErrCode>
+{
+    return validate(record).map([](std::uint32_t) {});
+}
+
+void BM_TryTransform(benchmark::State &state)
+{
+    rstd::par::ThreadPool pool(static_cast<unsigned>(state.range(0)));
+    const auto records = make_records(record_count);
+    for (auto _ : state) {
+        auto r = rstd::par::try_transform(pool, records, validate);
+        benchmark::DoNotOptimize(r);
+    }
+    state.SetItemsProcessed(state.iterations() * record_count);
+}
+
+void BM_TryForEach(benchmark::State &state)
+{
+    rstd::par::ThreadPool pool(static_cast<unsigned>(state.range(0)));
+    const auto records = make_records(record_count);
+    for (auto _ : state) {
+        auto r = rstd::par::try_for_each(pool, records, validate_only);
+        benchmark::DoNotOptimize(r);
+    }
+    state.SetItemsProcessed(state.iterations() * record_count);
+}
+
+void BM_TryReduce(benchmark::State &state)
+{
+    rstd::par::ThreadPool pool(static_cast<unsigned>(state.range(0)));
+    const auto records = make_records(record_count);
+    for (auto _ : state) {
+        auto r = rstd::par::try_reduce(pool, records, std::uint64_t{0},
+                                       std::plus<>{}, validate);
+        benchmark::DoNotOptimize(r);
+    }
+    state.SetItemsProcessed(state.iterations() * record_count);
+}
+
+void BM_FailEarly(benchmark::State &state)
+{
+    rstd::par::ThreadPool pool(static_cast<unsigned>(state.range(0)));
+    const auto records = make_records(record_count / 100);
+    for (auto _ : state) {
+        auto r = rstd::par::try_for_each(pool, records, validate_only);
+        benchmark::DoNotOptimize(r);
+    }
+}
+
+/**
+ * @brief Pool sizes 1, 2, 4, ... up to the hardware concurrency
+ */
+void thread_counts(benchmark::internal::Benchmark *b)
+{
+    const unsigned max = std::max(1u, std::thread::hardware_concurrency());
+    for (unsigned n = 1; n < max; n *= 2) {
+        b->Arg(n);
+    }
+    b->Arg(max);
+}
+
+} // namespace
+
+BENCHMARK(BM_TryTransform)->Apply(thread_counts)->UseRealTime();
+BENCHMARK(BM_TryForEach)->Apply(thread_counts)->UseRealTime();
+BENCHMARK(BM_TryReduce)->Apply(thread_counts)->UseRealTime();
+BENCHMARK(BM_FailEarly)->Apply(thread_counts)->UseRealTime();
+
+BENCHMARK_MAIN();
@@ -0,0 +1,153 @@
+/**
+ * @file storage_bench.cpp
+ * @brief Compare the tagged-union Result storage with a std::variant layout
+ */
+
+#include "rstd++/result.hpp"
+
+#include <benchmark/benchmark.h>
+#include <cstdint>
+#include <ostream>
+#include <string>
+#include <variant>
+#include <vector>
+
+using namespace rstd::result;
+
+namespace
+{
+
+enum class ErrCode : std::int32_t
+{
+    NotFound = 1,
+    Timeout,
+};
+
+auto operator<<(std::ostream &os, ErrCode code) -> std::ostream &
+{
+    return os << "ErrCode(" << static_cast<std::int32_t>(code) << ")";
+}
+
+/**
+ * @brief The layout Result used before the tagged-union storage engine
+ */
+template <typename T, typename E> class VariantResult
+{
+    struct Value
+    {
+        T value;
+    };
+    struct Error
+    {
+        E error;
+    };
+
+    std::variant<Value, Error> data_;
+
+    explicit VariantResult(Value v) : data_{std::move(v)} {}
+    explicit VariantResult(Error e) : data_{std::move(e)} {}
+
+public:
+    static auto Ok(T value) -> VariantResult
+    {
+        return VariantResult(Value{std::move(value)});
+    }
+
+    static auto Err(E error) -> VariantResult
+    {
+        return VariantResult(Error{std::move(error)});
+    }
+
+    [[nodiscard]] auto is_ok() const -> bool
+    {
+        return std::holds_alternative<Value>(data_);
+    }
+
+    [[nodiscard]] auto unwrap() const & -> T
+    {
+        return std::get<Value>(data_).value;
+    }
+
+    [[nodiscard]] auto unwrap_err() const & -> E
+    {
+        return std::get<Error>(data_).error;
+    }
+};
+
+template <template <typename, typename> class R, typename T>
+[[gnu::noinline]] auto produce(std::int32_t i, T payload) -> R<T, ErrCode>
+{
+    if ((i & 15) == 0) {
+        return R<T, ErrCode>::Err(ErrCode::Timeout);
+    }
+    return R<T, ErrCode>::Ok(std::move(payload));
+}
+
+template <template <typename, typename> class R>
+void BM_ReturnInt(benchmark::State &state)
+{
+    std::int64_t sum = 0;
+    std::int32_t i = 0;
+    for (auto _ : state) {
+        auto r = produce<R>(i, i);
+        if (r.is_ok()) {
+            sum += r.unwrap();
+        } else {
+            sum -= static_cast<std::int32_t>(r.unwrap_err());
+        }
+        benchmark::DoNotOptimize(sum);
+        ++i;
+    }
+    state.counters["sizeof"] = sizeof(R<std::int32_t, ErrCode>);
+}
+
+template <template <typename, typename> class R>
+void BM_ReturnString(benchmark::State &state)
+{
+    const std::string payload(static_cast<std::size_t>(state.range(0)), 'x');
+    std::size_t sum = 0;
+    std::int32_t i = 0;
+    for (auto _ : state) {
+        auto r = produce<R>(i++, payload);
+        if (r.is_ok()) {
+            sum += r.unwrap().size();
+        }
+        benchmark::DoNotOptimize(sum);
+    }
+    state.counters["sizeof"] = sizeof(R<std::string, ErrCode>);
+}
+
+template <template <typename, typename> class R>
+void BM_ScanArray(benchmark::State &state)
+{
+    std::vector<R<std::int32_t, ErrCode>> results;
+    results.reserve(static_cast<std::size_t>(state.range(0)));
+    for (std::int32_t i = 0; i < state.range(0); ++i) {
+        results.push_back(produce<R>(i, i));
+    }
+
+    for (auto _ : state) {
+        std::int64_t sum = 0;
+        for (const auto &r : results) {
+            if (r.is_ok()) {
+                sum += r.unwrap();
+            }
+        }
+        benchmark::DoNotOptimize(sum);
+    }
+    state.SetItemsProcessed(state.iterations() * state.range(0));
+    state.SetBytesProcessed(state.iterations() * state.range(0) *
+                            static_cast<std::int64_t>(
+                                sizeof(R<std::int32_t, ErrCode>)));
+}
+
+} // namespace
+
+BENCHMARK_TEMPLATE(BM_ReturnInt, Result);
+BENCHMARK_TEMPLATE(BM_ReturnInt, VariantResult);
+BENCHMARK_TEMPLATE(BM_ReturnString, Result)->Arg(8)->Arg(64);
+BENCHMARK_TEMPLATE(BM_ReturnString, VariantResult)->Arg(8)->Arg(64);
+BENCHMARK_TEMPLATE(BM_ScanArray, Result)->Arg(1 << 16);
+BENCHMARK_TEMPLATE(BM_ScanArray, VariantResult)->Arg(1 << 16);
+
+BENCHMARK_MAIN();
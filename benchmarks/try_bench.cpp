@@ -0,0 +1,84 @@
+/**
+ * @file try_bench.cpp
+ * @brief Compare RSTD_TRY with hand-written is_err()/unwrap() chains
+ *
+ * Both pipelines run the same three fallible steps. Build with
+ * `-S -fverbose-asm` to diff the generated code of try_chain() and
+ * manual_chain(): RSTD_TRY tests each discriminant once, while the manual
+ * chain also re-checks it inside unwrap() and unwrap_err().
+ */
+
+#include "rstd++/result.hpp"
+#include "rstd++/try.hpp"
+
+#include <benchmark/benchmark.h>
+#include <cstdint>
+#include <string>
+
+using namespace rstd::result;
+
+namespace
+{
+
+using Res = Result<std::int64_t, std::string>;
+
+[[gnu::noinline]] auto step(std::int64_t v, std::int64_t fail_every) -> Res
+{
+    if (fail_every != 0 && v % fail_every == 0) {
+        return Res::Err("step failed");
+    }
+    return Res::Ok(v + 1);
+}
+
+[[gnu::noinline]] auto try_chain(std::int64_t v, std::int64_t fail_every)
+    -> Res
+{
+    auto a = RSTD_TRY(step(v, fail_every));
+    auto b = RSTD_TRY(step(a, fail_every));
+    auto c = RSTD_TRY(step(b, fail_every));
+    return Res::Ok(c);
+}
+
+[[gnu::noinline]] auto manual_chain(std::int64_t v, std::int64_t fail_every)
+    -> Res
+{
+    auto ra = step(v, fail_every);
+    if (ra.is_err()) {
+        return Res::Err(std::move(ra).unwrap_err());
+    }
+    auto a = std::move(ra).unwrap();
+
+    auto rb = step(a, fail_every);
+    if (rb.is_err()) {
+        return Res::Err(std::move(rb).unwrap_err());
+    }
+    auto b = std::move(rb).unwrap();
+
+    auto rc = step(b, fail_every);
+    if (rc.is_err()) {
+        return Res::Err(std::move(rc).unwrap_err());
+    }
+    return Res::Ok(std::move(rc).unwrap());
+}
+
+template <auto Chain> void BM_Chain(benchmark::State &state)
+{
+    const std::int64_t fail_every = state.range(0);
+    std::int64_t i = 1;
+    std::int64_t sum = 0;
+    for (auto _ : state) {
+        auto r = Chain(i++, fail_every);
+        if (r.is_ok()) {
+            sum += std::move(r).unwrap();
+        }
+        benchmark::DoNotOptimize(sum);
+    }
+}
+
+} // namespace
+
+// Argument: one step in N fails (0 = never)
+BENCHMARK_TEMPLATE(BM_Chain, try_chain)->Arg(0)->Arg(2)->Arg(16);
+BENCHMARK_TEMPLATE(BM_Chain, manual_chain)->Arg(0)->Arg(2)->Arg(16);
+
+BENCHMARK_MAIN();
@@ -1,9 +1,13 @@
 #include <array>
 #include <iostream>
 #include <ostream>
+#include <ranges>
 #include <string>
+#include <vector>
 
+#include "rstd++/error.hpp"
 #include "rstd++/result.hpp"
+#include "rstd++/result_ranges.hpp"
 
 using namespace rstd;
 using namespace rstd::result;
@@ -12,9 +16,9 @@ using namespace rstd::result;
 auto divide(int a, int b) -> Result<int, const char *>
 {
     if (b == 0) {
-        return Err<int, const char *>("Division by zero");
+        return Err("Division by zero");
     }
-    return Ok<int, const char *>(a / b);
+    return Ok(a / b);
 }
 
 void division_example()
@@ -33,16 +37,16 @@ void division_example()
     std::cout << "\n";
 }
 
-// Example 2: Validation with Void
-auto validate_age(int age) -> Result<Void, const char *>
+// Example 2: Validation with no value
+auto validate_age(int age) -> Result<void, const char *>
 {
     if (age < 0) {
-        return Err<Void, const char *>("Age cannot be negative");
+        return Err("Age cannot be negative");
     }
     if (age > 150) {
-        return Err<Void, const char *>("Age too high");
+        return Err("Age too high");
     }
-    return Ok<Void, const char *>(Void{});
+    return Ok();
 }
 
 void validation_example()
@@ -107,12 +111,69 @@ void chaining_example()
     std::cout << "\n";
 }
 
+// Example 5: Compact errors that interoperate with std::error_code
+auto reserve_slot(int requested, int available) -> Result<int, Error>
+{
+    if (requested > available) {
+        return Err(std::errc::resource_unavailable_try_again);
+    }
+    return Ok(available - requested);
+}
+
+void error_example()
+{
+    std::cout << "=== Error Example ===\n";
+
+    auto r1 = reserve_slot(2, 8);
+    if (r1.is_ok()) {
+        std::cout << "Slots left: " << r1.unwrap() << "\n";
+    }
+
+    auto r2 = reserve_slot(9, 8);
+    if (r2.is_err()) {
+        std::cout << "Error: " << r2.unwrap_err() << "\n";
+    }
+    std::cout << "\n";
+}
+
+// Example 6: Parsing a whole list, stopping at the first failure
+void collect_example()
+{
+    std::cout << "=== Collect Example ===\n";
+
+    const std::vector<std::string> good = {"42", "123", "7"};
+    const std::vector<std::string> bad = {"42", "not a number", "7"};
+
+    auto all = good | std::views::transform(parse_number) |
+               collect<std::vector>();
+    if (all.is_ok()) {
+        std::cout << "Parsed " << all.unwrap_unchecked().size()
+                  << " numbers\n";
+    }
+
+    auto none = bad | std::views::transform(parse_number) |
+                collect<std::vector>();
+    if (none.is_err()) {
+        std::cout << "One of the inputs is not a number\n";
+    }
+
+    int sum = 0;
+    for (int n : bad | std::views::transform(parse_number) |
+                     views::ok_values) {
+        sum += n;
+    }
+    std::cout << "Sum of the valid inputs: " << sum << "\n";
+    std::cout << "\n";
+}
+
 void run_all()
 {
     division_example();
     validation_example();
     parsing_example();
     chaining_example();
+    error_example();
+    collect_example();
 }
 
 // ======================================================================
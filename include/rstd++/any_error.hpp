@@ -0,0 +1,385 @@
+#pragma once
+
+#include <cstddef>
+#include <cstring>
+#include <exception>
+#include <new>
+#include <ostream>
+#include <system_error>
+#include <type_traits>
+#include <typeinfo>
+#include <utility>
+
+#include "core.hpp"
+#include "niche.hpp"
+#include "result.hpp"
+
+/**
+ * @file any_error.hpp
+ * @brief A type-erased error that can hold any copyable error type
+ */
+
+namespace rstd
+{
+
+class AnyError;
+
+namespace __detail
+{
+
+/**
+ * @brief Bytes of error stored inside an AnyError before it spills to the
+ *        heap
+ */
+inline constexpr std::size_t any_error_capacity = 3 * sizeof(void *);
+
+/**
+ * @brief Types an AnyError can be built from
+ *
+ * Copyability is checked when the AnyError is built rather than here:
+ * asking for it in the constraint would recurse through the storage of
+ * Result<T, AnyError>, whose members are themselves constructible from
+ * anything an AnyError is.
+ */
+template <typename T>
+concept erasable_error = std::is_object_v<T> && !std::is_array_v<T> &&
+                         !std::is_const_v<T> && !std::is_volatile_v<T> &&
+                         !std::same_as<T, AnyError>;
+
+/**
+ * @brief Types that convert to AnyError implicitly
+ *
+ * Exceptions, error code enums, C strings, and printable classes and
+ * enums: the things a function plausibly reports as its error. Anything
+ * else erasable, such as an int or an unprintable struct, has to be wrapped
+ * explicitly.
+ */
+template <typename T>
+concept error_like =
+    std::derived_from<T, std::exception> || std::is_error_code_enum_v<T> ||
+    std::is_error_condition_enum_v<T> || std::same_as<T, const char *> ||
+    ((std::is_class_v<T> || std::is_enum_v<T>) && is_printable<T>);
+
+/**
+ * @brief Errors kept in the inline buffer: small, pointer-aligned, and
+ *        nothrow-movable so that moving an AnyError cannot throw
+ */
+template <typename T>
+concept any_error_inline = sizeof(T) <= any_error_capacity &&
+                           alignof(T) <= alignof(void *) &&
+                           std::is_nothrow_move_constructible_v<T>;
+
+/**
+ * @brief Operations on the erased error, one table per stored type
+ *
+ * A null relocate means the buffer can be moved with memcpy, and a null
+ * destroy means there is nothing to destroy. type is null in the table of
+ * a moved-from AnyError.
+ */
+struct any_error_vtable
+{
+#ifdef __cpp_rtti
+    const std::type_info *type;
+#endif
+    void (*copy)(std::byte *dst, const std::byte *src);
+    void (*relocate)(std::byte *dst, std::byte *src) noexcept;
+    void (*destroy)(std::byte *buf) noexcept;
+    void (*print)(std::ostream &os, const std::byte *buf);
+};
+
+template <typename T, bool Inline = any_error_inline<T>> struct any_error_ops;
+
+template <typename T> struct any_error_ops<T, true>
+{
+    static auto get(std::byte *buf) noexcept -> T *
+    {
+        return std::launder(reinterpret_cast<T *>(buf));
+    }
+
+    static auto get(const std::byte *buf) noexcept -> const T *
+    {
+        return std::launder(reinterpret_cast<const T *>(buf));
+    }
+
+    template <typename... Args>
+    static auto create(std::byte *buf, Args &&...args) -> void
+    {
+        ::new (static_cast<void *>(buf)) T(std::forward<Args>(args)...);
+    }
+
+    static auto copy(std::byte *dst, const std::byte *src) -> void
+    {
+        create(dst, *get(src));
+    }
+
+    static auto move_destroy(std::byte *dst, std::byte *src) noexcept -> void
+    {
+        T *from = get(src);
+        create(dst, std::move(*from));
+        from->~T();
+    }
+
+    static auto destroy_inline(std::byte *buf) noexcept -> void
+    {
+        get(buf)->~T();
+    }
+
+    static constexpr auto relocate =
+        std::is_trivially_copyable_v<T> ? nullptr : &move_destroy;
+    static constexpr auto destroy =
+        std::is_trivially_destructible_v<T> ? nullptr : &destroy_inline;
+};
+
+/**
+ * @brief Large errors live on the heap; the buffer holds their address
+ */
+template <typename T> struct any_error_ops<T, false>
+{
+    static auto get(const std::byte *buf) noexcept -> T *
+    {
+        T *ptr;
+        std::memcpy(&ptr, buf, sizeof(T *));
+        return ptr;
+    }
+
+    template <typename... Args>
+    static auto create(std::byte *buf, Args &&...args) -> void
+    {
+        T *ptr = new T(std::forward<Args>(args)...);
+        std::memcpy(buf, &ptr, sizeof(T *));
+    }
+
+    static auto copy(std::byte *dst, const std::byte *src) -> void
+    {
+        create(dst, *get(src));
+    }
+
+    static auto destroy_boxed(std::byte *buf) noexcept -> void
+    {
+        delete get(buf);
+    }
+
+    static constexpr auto relocate = nullptr;
+    static constexpr auto destroy = &destroy_boxed;
+};
+
+template <typename T>
+auto print_any_error(std::ostream &os, const std::byte *buf) -> void
+{
+    if constexpr (is_printable<T>) {
+        os << *any_error_ops<T>::get(buf);
+    } else {
+        os << "<unprintable error>";
+    }
+}
+
+template <typename T>
+inline constexpr any_error_vtable any_error_vtable_for{
+#ifdef __cpp_rtti
+    &typeid(T),
+#endif
+    &any_error_ops<T>::copy,
+    any_error_ops<T>::relocate,
+    any_error_ops<T>::destroy,
+    &print_any_error<T>,
+};
+
+/**
+ * @brief Table of a moved-from AnyError, which holds nothing
+ */
+inline constexpr any_error_vtable any_error_empty_vtable{
+#ifdef __cpp_rtti
+    nullptr,
+#endif
+    [](std::byte *, const std::byte *) {},
+    nullptr,
+    nullptr,
+    [](std::ostream &os, const std::byte *) { os << "<moved-from AnyError>"; },
+};
+
+} // namespace __detail
+
+/**
+ * @brief An error of any copyable type, for application-level code
+ *
+ * Errors of up to inline_capacity bytes that are nothrow-movable are stored
+ * in a buffer inside the AnyError, so creating one does not allocate;
+ * larger ones are boxed on the heap. The stored type is identified by the
+ * address of its operation table, so downcasting is usually one pointer
+ * comparison. Each shared object built with hidden visibility has its own
+ * tables, so when the addresses differ the std::type_info of the types is
+ * compared as well. Without RTTI only the address is compared, and an error
+ * created in another shared object never downcasts.
+ *
+ * Error-like types (see __detail::error_like) convert implicitly, which
+ * lets RSTD_TRY and Err(error) feed a Result<T, AnyError> directly; other
+ * types need an explicit AnyError(value):
+ *
+ * @code
+ * auto load(const std::string &path) -> Result<Config, AnyError>
+ * {
+ *     auto text = RSTD_TRY(read_file(path));  // Result<std::string, Error>
+ *     return parse(text);                     // Result<Config, ParseError>
+ * }
+ * @endcode
+ *
+ * A moved-from AnyError holds nothing; it may only be destroyed or
+ * assigned to.
+ */
+class AnyError
+{
+    alignas(void *) std::byte buf_[__detail::any_error_capacity];
+    const __detail::any_error_vtable *vtable_;
+
+    auto take(AnyError &other) noexcept -> void
+    {
+        vtable_ = std::exchange(other.vtable_,
+                                &__detail::any_error_empty_vtable);
+        if (vtable_->relocate != nullptr) {
+            vtable_->relocate(buf_, other.buf_);
+        } else {
+            std::memcpy(buf_, other.buf_, sizeof(buf_));
+        }
+    }
+
+    auto reset() noexcept -> void
+    {
+        if (vtable_->destroy != nullptr) {
+            vtable_->destroy(buf_);
+        }
+        vtable_ = &__detail::any_error_empty_vtable;
+    }
+
+public:
+    static constexpr std::size_t inline_capacity =
+        __detail::any_error_capacity;
+
+    /**
+     * @brief Whether an error of type T is stored without allocating
+     */
+    template <typename T>
+    static constexpr bool fits_inline = __detail::any_error_inline<T>;
+
+    /**
+     * @brief Hold a copy of @p error, implicitly if it is error-like
+     */
+    template <typename E>
+        requires __detail::erasable_error<std::decay_t<E>>
+    explicit(!__detail::error_like<std::decay_t<E>>) AnyError(E &&error)
+        : AnyError(std::in_place_type<std::decay_t<E>>, std::forward<E>(error))
+    {}
+
+    /**
+     * @brief Construct a T in place from @p args
+     */
+    template <typename T, typename... Args>
+        requires __detail::erasable_error<T> &&
+                 std::is_constructible_v<T, Args...>
+    explicit AnyError(std::in_place_type_t<T>, Args &&...args)
+    {
+        static_assert(std::is_copy_constructible_v<T>,
+                      "AnyError only holds copyable errors");
+        __detail::any_error_ops<T>::create(buf_, std::forward<Args>(args)...);
+        vtable_ = &__detail::any_error_vtable_for<T>;
+    }
+
+    AnyError(const AnyError &other) : vtable_{other.vtable_}
+    {
+        vtable_->copy(buf_, other.buf_);
+    }
+
+    AnyError(AnyError &&other) noexcept { take(other); }
+
+    auto operator=(const AnyError &other) -> AnyError &
+    {
+        if (this != &other) {
+            AnyError copy(other);
+            *this = std::move(copy);
+        }
+        return *this;
+    }
+
+    auto operator=(AnyError &&other) noexcept -> AnyError &
+    {
+        if (this != &other) {
+            reset();
+            take(other);
+        }
+        return *this;
+    }
+
+    ~AnyError() { reset(); }
+
+    /**
+     * @brief Whether the stored error is a T
+     */
+    template <typename T> [[nodiscard]] auto is() const noexcept -> bool
+    {
+        if (vtable_ == &__detail::any_error_vtable_for<T>) {
+            return true;
+        }
+#ifdef __cpp_rtti
+        return vtable_->type != nullptr && *vtable_->type == typeid(T);
+#else
+        return false;
+#endif
+    }
+
+    /**
+     * @brief The stored error if it is a T, null otherwise
+     */
+    template <typename T>
+    [[nodiscard]] auto downcast_ref() const noexcept -> const T *
+    {
+        return is<T>() ? __detail::any_error_ops<T>::get(buf_) : nullptr;
+    }
+
+    template <typename T> [[nodiscard]] auto downcast_mut() noexcept -> T *
+    {
+        return is<T>() ? __detail::any_error_ops<T>::get(buf_) : nullptr;
+    }
+
+    /**
+     * @brief Move the stored error out if it is a T, or give back the
+     *        AnyError unchanged
+     */
+    template <typename T>
+    [[nodiscard]] auto downcast() && -> result::Result<T, AnyError>
+    {
+        if (!is<T>()) {
+            return result::Result<T, AnyError>::Err(std::move(*this));
+        }
+        T error(std::move(*__detail::any_error_ops<T>::get(buf_)));
+        reset();
+        return result::Result<T, AnyError>::Ok(std::move(error));
+    }
+
+    /**
+     * @brief Print the stored error, or a placeholder if it is not
+     *        printable
+     *
+     * A template, so that looking for operator<< on a type that merely
+     * mentions AnyError does not try to convert it to one.
+     */
+    template <std::same_as<AnyError> A>
+    friend auto operator<<(std::ostream &os, const A &e) -> std::ostream &
+    {
+        e.vtable_->print(os, e.buf_);
+        return os;
+    }
+};
+
+static_assert(sizeof(AnyError) == AnyError::inline_capacity + sizeof(void *));
+static_assert(std::is_standard_layout_v<AnyError>);
+
+/**
+ * @brief The operation table pointer after the buffer is never null
+ */
+template <>
+struct niche_traits<AnyError>
+    : sentinel_niche<AnyError,
+                     static_cast<const __detail::any_error_vtable *>(nullptr),
+                     AnyError::inline_capacity>
+{};
+
+} // namespace rstd
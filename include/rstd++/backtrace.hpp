@@ -0,0 +1,324 @@
+#pragma once
+
+#include <atomic>
+#include <cstddef>
+#include <cstdint>
+#include <cstdlib>
+#include <memory>
+#include <ostream>
+#include <span>
+#include <type_traits>
+#include <utility>
+
+#if __has_include(<unwind.h>)
+#include <unwind.h>
+#define RSTD_BACKTRACE_UNWIND 1
+#else
+#define RSTD_BACKTRACE_UNWIND 0
+#endif
+
+#if __has_include(<dlfcn.h>)
+#include <dlfcn.h>
+#define RSTD_BACKTRACE_DLADDR 1
+#else
+#define RSTD_BACKTRACE_DLADDR 0
+#endif
+
+#if __has_include(<cxxabi.h>)
+#include <cxxabi.h>
+#define RSTD_BACKTRACE_DEMANGLE 1
+#else
+#define RSTD_BACKTRACE_DEMANGLE 0
+#endif
+
+#include "core.hpp"
+
+/**
+ * @file backtrace.hpp
+ * @brief Sampled stack traces attached to errors, symbolized on print
+ *
+ * Capturing only records raw return addresses. Turning them into function
+ * names happens when the trace is printed, for example by the panic of a
+ * failed unwrap(). Sampling is off until Backtrace::set_sample_rate() is
+ * called, so an unsampled error costs one relaxed atomic load.
+ *
+ * Symbols are looked up with dladdr(): functions of the main executable
+ * are only named when it is linked with `-rdynamic`; otherwise the frame
+ * shows its address and module.
+ */
+
+namespace rstd
+{
+
+namespace __detail
+{
+
+inline std::atomic<unsigned> backtrace_sample_rate{0};
+inline thread_local unsigned backtrace_sample_counter = 0;
+
+/**
+ * @brief Whether this call falls on the sampling rate, counted per thread
+ */
+inline auto backtrace_sampled() noexcept -> bool
+{
+    const unsigned rate = backtrace_sample_rate.load(std::memory_order_relaxed);
+    if (rate == 0) [[likely]] {
+        return false;
+    }
+    if (++backtrace_sample_counter < rate) {
+        return false;
+    }
+    backtrace_sample_counter = 0;
+    return true;
+}
+
+} // namespace __detail
+
+/**
+ * @brief Return addresses of a captured call stack, possibly empty
+ *
+ * An empty Backtrace is a null pointer; the frames of a captured one live
+ * in a single heap block.
+ */
+class Backtrace
+{
+public:
+    static constexpr std::size_t max_frames = 32;
+
+private:
+    struct frames
+    {
+        std::size_t count = 0;
+        void *ip[max_frames];
+    };
+
+    std::unique_ptr<frames> frames_;
+
+#if RSTD_BACKTRACE_UNWIND
+    struct unwind_state
+    {
+        frames *out;
+        std::size_t skip;
+    };
+
+    static auto unwind_frame(_Unwind_Context *ctx, void *arg)
+        -> _Unwind_Reason_Code
+    {
+        auto *state = static_cast<unwind_state *>(arg);
+        const auto ip = _Unwind_GetIP(ctx);
+        if (ip == 0) {
+            return _URC_END_OF_STACK;
+        }
+        if (state->skip > 0) {
+            --state->skip;
+            return _URC_NO_REASON;
+        }
+        frames &out = *state->out;
+        out.ip[out.count++] =
+            reinterpret_cast<void *>(static_cast<std::uintptr_t>(ip));
+        return out.count == max_frames ? _URC_END_OF_STACK : _URC_NO_REASON;
+    }
+#endif
+
+    static auto print_frame(std::ostream &os, const void *ip) -> void
+    {
+        os << ip;
+#if RSTD_BACKTRACE_DLADDR
+        Dl_info info{};
+        if (dladdr(ip, &info) == 0) {
+            return;
+        }
+        if (info.dli_sname != nullptr) {
+            const char *name = info.dli_sname;
+#if RSTD_BACKTRACE_DEMANGLE
+            int status = 0;
+            char *demangled =
+                abi::__cxa_demangle(name, nullptr, nullptr, &status);
+            if (status == 0 && demangled != nullptr) {
+                name = demangled;
+            }
+#endif
+            os << " in " << name << "+0x" << std::hex
+               << (static_cast<const char *>(ip) -
+                   static_cast<const char *>(info.dli_saddr))
+               << std::dec;
+#if RSTD_BACKTRACE_DEMANGLE
+            std::free(demangled);
+#endif
+        }
+        if (info.dli_fname != nullptr) {
+            os << " (" << info.dli_fname << ')';
+        }
+#endif
+    }
+
+public:
+    /**
+     * @brief An empty backtrace
+     */
+    constexpr Backtrace() noexcept = default;
+
+    Backtrace(const Backtrace &other)
+        : frames_{other.frames_ ? std::make_unique<frames>(*other.frames_)
+                                : nullptr}
+    {}
+
+    Backtrace(Backtrace &&other) noexcept = default;
+
+    auto operator=(const Backtrace &other) -> Backtrace &
+    {
+        if (this != &other) {
+            Backtrace copy(other);
+            frames_ = std::move(copy.frames_);
+        }
+        return *this;
+    }
+
+    auto operator=(Backtrace &&other) noexcept -> Backtrace & = default;
+
+    ~Backtrace() = default;
+
+    /**
+     * @brief Record the return addresses of the calling thread's stack
+     *
+     * The frame of capture() itself is left out. Empty on platforms
+     * without <unwind.h>.
+     */
+    [[nodiscard, gnu::noinline]] static auto capture() -> Backtrace
+    {
+        Backtrace bt;
+#if RSTD_BACKTRACE_UNWIND
+        bt.frames_ = std::make_unique<frames>();
+        unwind_state state{bt.frames_.get(), 1};
+        _Unwind_Backtrace(&unwind_frame, &state);
+#endif
+        return bt;
+    }
+
+    /**
+     * @brief capture() once every sample_rate() calls on this thread, an
+     *        empty backtrace otherwise
+     */
+    [[nodiscard]] static auto capture_sampled() -> Backtrace
+    {
+        if (!__detail::backtrace_sampled()) [[likely]] {
+            return Backtrace();
+        }
+        return capture();
+    }
+
+    /**
+     * @brief Capture one in @p every sampled calls; 0 turns sampling off
+     *
+     * @return the previous rate
+     */
+    static auto set_sample_rate(unsigned every) noexcept -> unsigned
+    {
+        return __detail::backtrace_sample_rate.exchange(
+            every, std::memory_order_relaxed);
+    }
+
+    [[nodiscard]] static auto sample_rate() noexcept -> unsigned
+    {
+        return __detail::backtrace_sample_rate.load(std::memory_order_relaxed);
+    }
+
+    [[nodiscard]] auto is_captured() const noexcept -> bool
+    {
+        return frames_ != nullptr;
+    }
+
+    /**
+     * @brief The raw return addresses, innermost first
+     */
+    [[nodiscard]] auto addresses() const noexcept -> std::span<void *const>
+    {
+        if (!frames_) {
+            return {};
+        }
+        return {frames_->ip, frames_->count};
+    }
+
+    /**
+     * @brief Print one symbolized line per frame
+     */
+    friend auto operator<<(std::ostream &os, const Backtrace &bt)
+        -> std::ostream &
+    {
+        os << "stack backtrace:";
+        std::size_t i = 0;
+        for (const void *ip : bt.addresses()) {
+            os << "\n  #" << i++ << ' ';
+            print_frame(os, ip);
+        }
+        return os;
+    }
+};
+
+/**
+ * @brief An error of type E carrying a sampled backtrace of where it was
+ *        created
+ *
+ * Converts implicitly from E, so Err(error) and RSTD_TRY fill a
+ * Result<T, Traced<E>> from plain errors. Printing it, as a failed
+ * unwrap() does, prints the error followed by the backtrace if one was
+ * sampled.
+ *
+ * @code
+ * rstd::Backtrace::set_sample_rate(100);
+ * auto parse(std::string_view s) -> Result<int, Traced<ParseError>>;
+ * @endcode
+ */
+template <typename E> class Traced
+{
+    E error_;
+    Backtrace backtrace_;
+
+public:
+    Traced(const E &error)
+        : error_{error}, backtrace_{Backtrace::capture_sampled()}
+    {}
+
+    Traced(E &&error)
+        : error_{std::move(error)}, backtrace_{Backtrace::capture_sampled()}
+    {}
+
+    template <typename... Args>
+        requires std::is_constructible_v<E, Args...>
+    explicit Traced(std::in_place_t, Args &&...args)
+        : error_(std::forward<Args>(args)...),
+          backtrace_{Backtrace::capture_sampled()}
+    {}
+
+    [[nodiscard]] auto error() & noexcept -> E & { return error_; }
+
+    [[nodiscard]] auto error() const & noexcept -> const E & { return error_; }
+
+    [[nodiscard]] auto error() && noexcept -> E && { return std::move(error_); }
+
+    [[nodiscard]] auto backtrace() const noexcept -> const Backtrace &
+    {
+        return backtrace_;
+    }
+
+    /**
+     * @brief Compare the errors, ignoring where they were created
+     */
+    [[nodiscard]] friend auto operator==(const Traced &lhs, const Traced &rhs)
+        -> bool
+    {
+        return lhs.error_ == rhs.error_;
+    }
+
+    friend auto operator<<(std::ostream &os, const Traced &t) -> std::ostream &
+        requires is_printable<E>
+    {
+        os << t.error_;
+        if (t.backtrace_.is_captured()) {
+            os << '\n' << t.backtrace_;
+        }
+        return os;
+    }
+};
+
+} // namespace rstd
@@ -0,0 +1,223 @@
+#pragma once
+
+#include <array>
+#include <cstddef>
+#include <cstdint>
+#include <cstring>
+#include <ostream>
+#include <span>
+#include <type_traits>
+#include <utility>
+
+#include "core.hpp"
+
+/**
+ * @file context.hpp
+ * @brief Context frames attached to an error as it propagates
+ *
+ * Result::context() records what the caller was doing when the error went
+ * past:
+ *
+ * @code
+ * auto load() -> Result<Config, Context<ParseError>>
+ * {
+ *     auto port = RSTD_TRY(parse_number(s).context("reading line", 12));
+ *     ...
+ * }
+ * @endcode
+ *
+ * A frame is a pointer to a message with static storage duration plus at
+ * most one small trivially copyable argument, kept in a fixed array inside
+ * the error. Adding context never allocates and never formats; the chain
+ * is rendered only when the error is printed, outermost frame first:
+ * `loading config: reading line 12: invalid digit`.
+ */
+
+#ifndef RSTD_CONTEXT_CAPACITY
+#define RSTD_CONTEXT_CAPACITY 4
+#endif
+
+namespace rstd
+{
+
+/**
+ * @brief Argument types a context frame can carry inline
+ */
+template <typename A>
+concept context_arg = std::is_trivially_copyable_v<A> &&
+                      sizeof(A) <= sizeof(std::uint64_t) &&
+                      alignof(A) <= alignof(std::uint64_t) && is_printable<A>;
+
+/**
+ * @brief One level of context: a static message and an optional argument
+ */
+class ContextFrame
+{
+    using print_fn = void (*)(std::ostream &os, const std::byte *arg);
+
+    const char *message_ = nullptr;
+    print_fn print_arg_ = nullptr;
+    alignas(std::uint64_t) std::byte arg_[sizeof(std::uint64_t)]{};
+
+    template <typename A>
+    static auto print_arg(std::ostream &os, const std::byte *arg) -> void
+    {
+        A value;
+        std::memcpy(&value, arg, sizeof(A));
+        os << value;
+    }
+
+public:
+    constexpr ContextFrame() noexcept = default;
+
+    /**
+     * @param message must outlive the frame, as a string literal does
+     */
+    constexpr explicit ContextFrame(const char *message) noexcept
+        : message_{message}
+    {}
+
+    template <typename A>
+        requires context_arg<A>
+    ContextFrame(const char *message, const A &arg) noexcept
+        : message_{message}, print_arg_{&print_arg<A>}
+    {
+        std::memcpy(arg_, &arg, sizeof(A));
+    }
+
+    [[nodiscard]] constexpr auto message() const noexcept -> const char *
+    {
+        return message_;
+    }
+
+    [[nodiscard]] constexpr auto has_arg() const noexcept -> bool
+    {
+        return print_arg_ != nullptr;
+    }
+
+    /**
+     * @brief Print as `message` or `message arg`
+     */
+    friend auto operator<<(std::ostream &os, const ContextFrame &frame)
+        -> std::ostream &
+    {
+        os << frame.message_;
+        if (frame.print_arg_ != nullptr) {
+            os << ' ';
+            frame.print_arg_(os, frame.arg_);
+        }
+        return os;
+    }
+};
+
+static_assert(std::is_trivially_copyable_v<ContextFrame>);
+
+/**
+ * @brief An error of type E with the context frames added on its way up
+ *
+ * Converts implicitly from E, so RSTD_TRY and Err(error) fill a
+ * Result<T, Context<E>> from plain errors. The first `capacity` frames,
+ * those closest to the error, are kept; later ones are only counted.
+ */
+template <typename E> class Context
+{
+public:
+    static constexpr std::size_t capacity = RSTD_CONTEXT_CAPACITY;
+
+private:
+    E error_;
+    std::size_t depth_ = 0;
+    std::array<ContextFrame, capacity> frames_{};
+
+public:
+    Context(const E &error) : error_{error} {}
+
+    Context(E &&error) : error_{std::move(error)} {}
+
+    template <typename... Args>
+        requires std::is_constructible_v<E, Args...>
+    explicit Context(std::in_place_t, Args &&...args)
+        : error_(std::forward<Args>(args)...)
+    {}
+
+    /**
+     * @brief Add @p frame as the new outermost context
+     */
+    auto push(const ContextFrame &frame) noexcept -> Context &
+    {
+        if (depth_ < capacity) {
+            frames_[depth_] = frame;
+        }
+        ++depth_;
+        return *this;
+    }
+
+    [[nodiscard]] auto error() & noexcept -> E & { return error_; }
+
+    [[nodiscard]] auto error() const & noexcept -> const E & { return error_; }
+
+    [[nodiscard]] auto error() && noexcept -> E && { return std::move(error_); }
+
+    /**
+     * @brief The stored frames, innermost first
+     */
+    [[nodiscard]] auto frames() const noexcept -> std::span<const ContextFrame>
+    {
+        return {frames_.data(), depth_ < capacity ? depth_ : capacity};
+    }
+
+    /**
+     * @brief Number of frames pushed, including those that did not fit
+     */
+    [[nodiscard]] auto depth() const noexcept -> std::size_t { return depth_; }
+
+    /**
+     * @brief Compare the errors, ignoring their context
+     */
+    [[nodiscard]] friend auto operator==(const Context &lhs,
+                                         const Context &rhs) -> bool
+    {
+        return lhs.error_ == rhs.error_;
+    }
+
+    /**
+     * @brief Print the frames outermost first, then the error
+     */
+    friend auto operator<<(std::ostream &os, const Context &c)
+        -> std::ostream &
+        requires is_printable<E>
+    {
+        const auto frames = c.frames();
+        if (c.depth_ > frames.size()) {
+            os << "<" << c.depth_ - frames.size() << " more>: ";
+        }
+        for (auto it = frames.rbegin(); it != frames.rend(); ++it) {
+            os << *it << ": ";
+        }
+        return os << c.error_;
+    }
+};
+
+namespace __detail
+{
+
+template <typename E> struct with_context
+{
+    using type = Context<E>;
+};
+
+template <typename E> struct with_context<Context<E>>
+{
+    using type = Context<E>;
+};
+
+} // namespace __detail
+
+/**
+ * @brief Error type of a Result after context(): E wrapped in Context
+ *        once, however many frames are added
+ */
+template <typename E>
+using context_t = typename __detail::with_context<std::remove_cvref_t<E>>::type;
+
+} // namespace rstd
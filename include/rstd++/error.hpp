@@ -0,0 +1,154 @@
+#pragma once
+
+#include <cerrno>
+#include <cstdint>
+#include <ostream>
+#include <string>
+#include <system_error>
+#include <type_traits>
+
+#include "niche.hpp"
+
+/**
+ * @file error.hpp
+ * @brief A compact error value: category pointer plus integer code
+ */
+
+namespace rstd
+{
+
+/**
+ * @brief Base for error categories whose messages are static strings
+ *
+ * An ErrorCategory is a std::error_category, so its errors convert to and
+ * from std::error_code without translation. Its constructor is constexpr:
+ * declare categories `constinit` so they need no dynamic initialization.
+ *
+ * @code
+ * struct ShedCategory final : rstd::ErrorCategory
+ * {
+ *     auto name() const noexcept -> const char * override { return "shed"; }
+ *     auto describe(int code) const noexcept -> const char * override;
+ * };
+ * inline constinit const ShedCategory shed_category;
+ * @endcode
+ */
+class ErrorCategory : public std::error_category
+{
+public:
+    constexpr ErrorCategory() noexcept = default;
+
+    /**
+     * @brief Static description of @p code
+     */
+    [[nodiscard]] virtual auto describe(int code) const noexcept
+        -> const char * = 0;
+
+    [[nodiscard]] auto message(int code) const -> std::string final
+    {
+        return describe(code);
+    }
+};
+
+/**
+ * @brief An error code tagged with the category that gives it meaning
+ *
+ * Two words, trivially copyable, and never allocating: creating an Error
+ * stores a pointer and an int. The message is only looked up when the error
+ * is printed or message() is called.
+ *
+ * Error itself is 16 bytes on 64-bit targets, not 8: a category pointer and
+ * a 32-bit code cannot share one word portably. What stays at 16 bytes is
+ * the Result: the category pointer is never null, which gives Error a niche,
+ * so a Result<T, Error> with a small T is no larger than the Error itself.
+ */
+class Error
+{
+    const std::error_category *category_;
+    std::int32_t code_;
+
+public:
+    constexpr Error(int code, const std::error_category &category) noexcept
+        : category_{&category}, code_{code}
+    {}
+
+    Error(std::error_code ec) noexcept : Error(ec.value(), ec.category()) {}
+
+    Error(std::errc e) noexcept : Error(std::make_error_code(e)) {}
+
+    template <typename Enum>
+        requires std::is_error_code_enum_v<Enum>
+    Error(Enum e) noexcept : Error(make_error_code(e))
+    {}
+
+    /**
+     * @brief Error for an errno value, in std::generic_category()
+     */
+    [[nodiscard]] static auto from_errno(int errnum) noexcept -> Error
+    {
+        return Error(errnum, std::generic_category());
+    }
+
+    /**
+     * @brief Error for the current value of errno
+     */
+    [[nodiscard]] static auto last_errno() noexcept -> Error
+    {
+        return from_errno(errno);
+    }
+
+    [[nodiscard]] constexpr auto code() const noexcept -> int { return code_; }
+
+    [[nodiscard]] constexpr auto category() const noexcept
+        -> const std::error_category &
+    {
+        return *category_;
+    }
+
+    [[nodiscard]] auto message() const -> std::string
+    {
+        return category_->message(code_);
+    }
+
+    [[nodiscard]] auto to_error_code() const noexcept -> std::error_code
+    {
+        return {code_, *category_};
+    }
+
+    [[nodiscard]] friend constexpr auto operator==(const Error &lhs,
+                                                   const Error &rhs) noexcept
+        -> bool
+    {
+        return lhs.category_ == rhs.category_ && lhs.code_ == rhs.code_;
+    }
+
+    [[nodiscard]] friend auto operator==(const Error &lhs,
+                                         const std::error_code &rhs) noexcept
+        -> bool
+    {
+        return lhs.to_error_code() == rhs;
+    }
+
+    /**
+     * @brief Print as `category:code (message)`
+     */
+    friend auto operator<<(std::ostream &os, const Error &e) -> std::ostream &
+    {
+        return os << e.category_->name() << ':' << e.code_ << " ("
+                  << e.message() << ')';
+    }
+};
+
+static_assert(std::is_trivially_copyable_v<Error>);
+static_assert(std::is_standard_layout_v<Error>);
+
+/**
+ * @brief The category pointer at the start of Error is never null
+ */
+template <>
+struct niche_traits<Error>
+    : sentinel_niche<Error, static_cast<const std::error_category *>(nullptr),
+                     0>
+{};
+
+} // namespace rstd
@@ -0,0 +1,163 @@
+#pragma once
+
+#include <bit>
+#include <cstddef>
+#include <cstring>
+#include <memory>
+#include <type_traits>
+
+namespace rstd
+{
+
+/**
+ * @brief Customization point describing spare representations of a type
+ *
+ * A niche is a bit pattern that no live object of type T ever has, such as
+ * an odd address in a pointer to an aligned type. Layout-aware containers
+ * like Result mark their "other" state with that pattern instead of a
+ * separate discriminant, and reuse the bytes of T that the pattern leaves
+ * untouched for their own data.
+ *
+ * The primary template declares that T has no niche. A specialization that
+ * enables one provides:
+ *  - `has_niche = true`
+ *  - `payload_offset`, `payload_size`: the byte range of T's representation
+ *    that set_niche() does not touch and is free while in the niche state
+ *  - `is_niche(const std::byte *repr)`: whether the sizeof(T) bytes at
+ *    @p repr hold the niche pattern
+ *  - `set_niche(std::byte *repr)`: write the niche pattern into @p repr
+ *
+ * Both functions work on raw storage; they must not assume a live T.
+ */
+template <typename T> struct niche_traits
+{
+    static constexpr bool has_niche = false;
+};
+
+/**
+ * @brief Niche made of one reserved value of a field of T
+ *
+ * @tparam T the type described by the niche
+ * @tparam Sentinel a value of the field type that live objects never hold
+ * @tparam Offset byte offset of the field inside T
+ *
+ * The payload is the larger of the byte ranges before and after the field.
+ * Specialize niche_traits for an enum or a handle type by deriving from it:
+ * @code
+ * template <>
+ * struct rstd::niche_traits<Handle>
+ *     : rstd::sentinel_niche<Handle, Handle::invalid_id, 0>
+ * {};
+ * @endcode
+ */
+template <typename T, auto Sentinel, std::size_t Offset = 0>
+struct sentinel_niche
+{
+private:
+    using field_type = decltype(Sentinel);
+
+    static_assert(std::is_trivially_copyable_v<field_type>,
+                  "Sentinel must be a trivially copyable value");
+    static_assert(Offset + sizeof(field_type) <= sizeof(T),
+                  "Sentinel field must lie inside T");
+
+    static constexpr std::size_t tail_offset = Offset + sizeof(field_type);
+    static constexpr std::size_t tail_size = sizeof(T) - tail_offset;
+
+public:
+    static constexpr bool has_niche = true;
+    static constexpr std::size_t payload_offset =
+        tail_size >= Offset ? tail_offset : 0;
+    static constexpr std::size_t payload_size =
+        tail_size >= Offset ? tail_size : Offset;
+
+    static auto is_niche(const std::byte *repr) noexcept -> bool
+    {
+        field_type field;
+        std::memcpy(&field, repr + Offset, sizeof(field_type));
+        return field == Sentinel;
+    }
+
+    static auto set_niche(std::byte *repr) noexcept -> void
+    {
+        constexpr field_type sentinel = Sentinel;
+        std::memcpy(repr + Offset, &sentinel, sizeof(field_type));
+    }
+};
+
+/**
+ * @brief Customization point giving the alignment every T is known to have
+ *
+ * Pointers to T get a low-bit niche when this is at least 2. It must not
+ * depend on whether T is complete, or Result<T *, E> would have a different
+ * layout in translation units that only forward-declare T. Scalar types
+ * are always complete and use their own alignment; class types default to
+ * 1, i.e. no niche, and opt in by specializing:
+ * @code
+ * struct Impl;
+ * template <>
+ * struct rstd::pointee_alignment<Impl> : std::integral_constant<std::size_t, 8>
+ * {};
+ * @endcode
+ */
+template <typename T>
+struct pointee_alignment : std::integral_constant<std::size_t, 1>
+{};
+
+template <typename T>
+    requires std::is_scalar_v<T>
+struct pointee_alignment<T> : std::integral_constant<std::size_t, alignof(T)>
+{};
+
+namespace __detail
+{
+
+template <typename T>
+concept low_bit_free_pointee =
+    std::is_object_v<T> && pointee_alignment<std::remove_cv_t<T>>::value >= 2;
+
+} // namespace __detail
+
+/**
+ * @brief Pointers to types aligned to at least 2 never have the low bit set
+ *
+ * The niche sets that bit in the byte holding the least significant bits of
+ * the address; the remaining bytes of the pointer form the payload. The
+ * alignment comes from pointee_alignment, never from alignof(T), so the
+ * layout is the same whether or not T is complete.
+ */
+template <typename T>
+    requires __detail::low_bit_free_pointee<T>
+struct niche_traits<T *>
+{
+private:
+    static constexpr std::size_t tag_byte =
+        std::endian::native == std::endian::little ? 0 : sizeof(T *) - 1;
+
+public:
+    static constexpr bool has_niche = true;
+    static constexpr std::size_t payload_offset = tag_byte == 0 ? 1 : 0;
+    static constexpr std::size_t payload_size = sizeof(T *) - 1;
+
+    static auto is_niche(const std::byte *repr) noexcept -> bool
+    {
+        return (repr[tag_byte] & std::byte{1}) != std::byte{0};
+    }
+
+    static auto set_niche(std::byte *repr) noexcept -> void
+    {
+        repr[tag_byte] = std::byte{1};
+    }
+};
+
+/**
+ * @brief A std::unique_ptr with the default deleter is laid out as its
+ *        pointer, so it shares the pointer niche
+ */
+template <typename T>
+    requires(__detail::low_bit_free_pointee<T> &&
+             sizeof(std::unique_ptr<T>) == sizeof(T *))
+struct niche_traits<std::unique_ptr<T>> : niche_traits<T *>
+{};
+
+} // namespace rstd
@@ -0,0 +1,905 @@
+#pragma once
+
+#include <cassert>
+#include <compare>
+#include <concepts>
+#include <cstddef>
+#include <functional>
+#include <memory>
+#include <optional>
+#include <ostream>
+#include <type_traits>
+#include <utility>
+
+#include "core.hpp"
+#include "niche.hpp"
+#include "panic.hpp"
+#include "relocate.hpp"
+#include "result.hpp"
+
+/**
+ * @file option.hpp
+ * @brief Option<T>: an optional value with the combinators of Result
+ *
+ * @code
+ * auto port = find_setting("port")             // Option<const std::string &>
+ *                 .and_then(parse_port)         // Option<NonZero<uint16_t>>
+ *                 .ok_or(ConfigError::MissingPort); // Result<..., ConfigError>
+ * @endcode
+ *
+ * An Option is no larger than T when T has a niche: references and
+ * NonZero<T> integers use zero, pointers to aligned types an odd address,
+ * and types with a niche_traits specialization, such as enums built on
+ * sentinel_niche, their reserved value. Everything else gets a flag next
+ * to the value, as in std::optional. Like the packed layouts of Result,
+ * niche layouts cannot be used in constant evaluation.
+ */
+
+namespace rstd
+{
+
+template <typename T> class Option;
+
+/**
+ * @brief Type of `none`, the empty Option of any type
+ */
+struct NoneType
+{
+    constexpr explicit NoneType(int) noexcept {}
+};
+
+inline constexpr NoneType none{0};
+
+/**
+ * @brief An integer that is never zero, leaving zero as a niche
+ *
+ * Option<NonZero<T>> has the size of T, which makes it suitable for
+ * optional indices and handles in dense tables. Build one with make() from
+ * a value that may be zero, or with the constructor from one that is known
+ * not to be.
+ */
+template <std::integral T> class NonZero
+{
+    T value_;
+
+public:
+    using value_type = T;
+
+    /**
+     * @brief Wrap @p value, which must not be zero
+     */
+    constexpr explicit NonZero(T value) noexcept : value_{value}
+    {
+        assert(value != 0 && "NonZero built from zero");
+    }
+
+    /**
+     * @brief Some(NonZero(value)), or None for zero
+     */
+    [[nodiscard]] static constexpr auto make(T value) noexcept
+        -> Option<NonZero>;
+
+    [[nodiscard]] constexpr auto get() const noexcept -> T { return value_; }
+
+    friend constexpr auto operator==(const NonZero &,
+                                     const NonZero &) -> bool = default;
+    friend constexpr auto operator<=>(const NonZero &,
+                                      const NonZero &) = default;
+
+    friend auto operator<<(std::ostream &os, const NonZero &n)
+        -> std::ostream &
+    {
+        return os << n.value_;
+    }
+};
+
+template <std::integral T>
+struct niche_traits<NonZero<T>> : sentinel_niche<NonZero<T>, T{0}>
+{};
+
+namespace __detail
+{
+
+using result::__detail::is_option_v;
+
+// The special members of option_storage<T> are those of a Result storage of
+// T and Void, so the same concepts pick the trivial ones
+using result::__detail::copy_assignable_pair;
+using result::__detail::copy_constructible_pair;
+using result::__detail::move_assignable_pair;
+using result::__detail::move_constructible_pair;
+using result::__detail::trivially_copy_assignable_pair;
+using result::__detail::trivially_copy_constructible_pair;
+using result::__detail::trivially_destructible_pair;
+using result::__detail::trivially_move_assignable_pair;
+using result::__detail::trivially_move_constructible_pair;
+using result::__detail::trivially_relocatable_pair;
+
+/**
+ * @brief Storage of Option<T>: the value in a union, plus a flag unless
+ *        niche_traits<T> gives T a niche to mark the empty state with
+ *
+ * Copy, move and destruction are trivial whenever they are for T.
+ */
+template <typename T> class RSTD_TRIVIAL_ABI option_storage
+{
+    static constexpr bool packed = niche_traits<T>::has_niche;
+
+    rstd::__detail::raw_union<Void, T> payload_;
+    [[no_unique_address]] std::conditional_t<
+        packed, result::__detail::no_discriminant, bool> some_;
+
+    auto repr() noexcept -> std::byte *
+    {
+        return reinterpret_cast<std::byte *>(std::addressof(payload_));
+    }
+
+    auto repr() const noexcept -> const std::byte *
+    {
+        return reinterpret_cast<const std::byte *>(std::addressof(payload_));
+    }
+
+    constexpr auto set_some(bool some) noexcept -> void
+    {
+        if constexpr (packed) {
+            if (!some) {
+                niche_traits<T>::set_niche(repr());
+            }
+        } else {
+            some_ = some;
+        }
+    }
+
+    template <typename Other>
+    constexpr auto construct_from(Other &&other) -> void
+    {
+        if (other.is_some()) {
+            std::construct_at(std::addressof(payload_.second),
+                              std::forward<Other>(other).payload_.second);
+            set_some(true);
+        } else {
+            set_some(false);
+        }
+    }
+
+    template <typename Other> constexpr auto assign(Other &&other) -> void
+    {
+        if (is_some() && other.is_some()) {
+            payload_.second = std::forward<Other>(other).payload_.second;
+        } else if (other.is_some()) {
+            std::construct_at(std::addressof(payload_.second),
+                              std::forward<Other>(other).payload_.second);
+            set_some(true);
+        } else {
+            reset();
+        }
+    }
+
+public:
+    constexpr option_storage() noexcept : payload_(std::in_place_index<0>)
+    {
+        set_some(false);
+    }
+
+    template <typename... Args>
+    constexpr explicit option_storage(std::in_place_t, Args &&...args)
+        : payload_(std::in_place_index<1>, std::forward<Args>(args)...)
+    {
+        set_some(true);
+    }
+
+    constexpr option_storage(const option_storage &)
+        requires trivially_copy_constructible_pair<T, Void>
+    = default;
+
+    constexpr option_storage(const option_storage &other) noexcept(
+        std::is_nothrow_copy_constructible_v<T>)
+        requires copy_constructible_pair<T, Void>
+        : payload_(std::in_place_index<0>)
+    {
+        construct_from(other);
+    }
+
+    constexpr option_storage(option_storage &&)
+        requires trivially_move_constructible_pair<T, Void>
+    = default;
+
+    constexpr option_storage(option_storage &&other) noexcept(
+        std::is_nothrow_move_constructible_v<T>)
+        requires move_constructible_pair<T, Void>
+        : payload_(std::in_place_index<0>)
+    {
+        construct_from(std::move(other));
+    }
+
+    constexpr auto operator=(const option_storage &) -> option_storage &
+        requires trivially_copy_assignable_pair<T, Void>
+    = default;
+
+    constexpr auto operator=(const option_storage &other) -> option_storage &
+        requires copy_assignable_pair<T, Void>
+    {
+        assign(other);
+        return *this;
+    }
+
+    constexpr auto operator=(option_storage &&) -> option_storage &
+        requires trivially_move_assignable_pair<T, Void>
+    = default;
+
+    constexpr auto operator=(option_storage &&other) noexcept(
+        std::is_nothrow_move_constructible_v<T> &&
+        std::is_nothrow_move_assignable_v<T>) -> option_storage &
+        requires move_assignable_pair<T, Void>
+    {
+        assign(std::move(other));
+        return *this;
+    }
+
+    constexpr ~option_storage()
+        requires trivially_destructible_pair<T, Void>
+    = default;
+
+    constexpr ~option_storage()
+    {
+        if (is_some()) {
+            std::destroy_at(std::addressof(payload_.second));
+        }
+    }
+
+    [[nodiscard]] constexpr auto is_some() const noexcept -> bool
+    {
+        if constexpr (packed) {
+            return !niche_traits<T>::is_niche(repr());
+        } else {
+            return some_;
+        }
+    }
+
+    [[nodiscard]] constexpr auto value() & noexcept -> T &
+    {
+        return payload_.second;
+    }
+
+    [[nodiscard]] constexpr auto value() const & noexcept -> const T &
+    {
+        return payload_.second;
+    }
+
+    [[nodiscard]] constexpr auto value() && noexcept -> T &&
+    {
+        return std::move(payload_.second);
+    }
+
+    template <typename... Args> constexpr auto emplace(Args &&...args) -> T &
+    {
+        reset();
+        std::construct_at(std::addressof(payload_.second),
+                          std::forward<Args>(args)...);
+        set_some(true);
+        return payload_.second;
+    }
+
+    constexpr auto reset() noexcept -> void
+    {
+        if (is_some()) {
+            std::destroy_at(std::addressof(payload_.second));
+            set_some(false);
+        }
+    }
+};
+
+/**
+ * @brief Storage of Option<T &>: a pointer, null when empty
+ */
+template <typename T> class option_storage<T &>
+{
+    T *ptr_ = nullptr;
+
+public:
+    constexpr option_storage() noexcept = default;
+
+    constexpr explicit option_storage(std::in_place_t, T &ref) noexcept
+        : ptr_{std::addressof(ref)}
+    {}
+
+    option_storage(std::in_place_t, const T &&) = delete;
+
+    [[nodiscard]] constexpr auto is_some() const noexcept -> bool
+    {
+        return ptr_ != nullptr;
+    }
+
+    [[nodiscard]] constexpr auto value() const noexcept -> T & { return *ptr_; }
+
+    constexpr auto emplace(T &ref) noexcept -> T &
+    {
+        ptr_ = std::addressof(ref);
+        return ref;
+    }
+
+    constexpr auto reset() noexcept -> void { ptr_ = nullptr; }
+};
+
+/**
+ * @brief Panic for an Option accessed while empty
+ *
+ * Not constexpr, so that doing this in a constant expression is a compile
+ * error naming this function.
+ */
+[[noreturn]] inline void none_failed(const char *msg)
+{
+    panic::__detail::begin_panic(msg, nullptr, nullptr);
+}
+
+} // namespace __detail
+
+/**
+ * @brief An optional T with the combinators of Result
+ *
+ * Build one with Option<T>::Some(value), Some(value) or none. An Option of
+ * a reference refers to the object instead of holding a copy. The accessors
+ * of std::optional (has_value(), value(), value_or(), operator*), the
+ * comparison with std::nullopt and an implicit conversion to std::optional
+ * are provided too, so code written against Result::ok() returning
+ * std::optional keeps working.
+ */
+template <typename T> class Option
+{
+    static_assert(!std::is_void_v<T>, "Option<void> is a bool");
+
+    __detail::option_storage<T> data_;
+
+    using ref = std::add_lvalue_reference_t<T>;
+    using cref = std::conditional_t<std::is_reference_v<T>, T,
+                                    const std::remove_reference_t<T> &>;
+    using rref = std::add_rvalue_reference_t<T>;
+
+    template <typename U> friend class Option;
+
+public:
+    using value_type = T;
+
+    constexpr Option() noexcept = default;
+    constexpr Option(NoneType) noexcept {}
+
+    template <typename... Args>
+    constexpr explicit Option(std::in_place_t, Args &&...args)
+        : data_{std::in_place, std::forward<Args>(args)...}
+    {}
+
+    template <typename U = T>
+        requires std::is_constructible_v<T, U &&>
+    [[nodiscard]] static constexpr auto Some(U &&value) -> Option
+    {
+        return Option(std::in_place, std::forward<U>(value));
+    }
+
+    [[nodiscard]] static constexpr auto None() noexcept -> Option
+    {
+        return Option();
+    }
+
+    // ======================================================================
+    // Querying the variant
+    // ======================================================================
+
+    [[nodiscard]] constexpr auto is_some() const noexcept -> bool
+    {
+        return data_.is_some();
+    }
+
+    [[nodiscard]] constexpr auto is_none() const noexcept -> bool
+    {
+        return !data_.is_some();
+    }
+
+    template <typename Pred>
+        requires fn_return_boolean<Pred, cref>
+    [[nodiscard]] constexpr auto is_some_and(Pred &&pred) const & -> bool
+    {
+        return is_some() && std::invoke(std::forward<Pred>(pred), get());
+    }
+
+    template <typename Pred>
+        requires fn_return_boolean<Pred, T>
+    [[nodiscard]] constexpr auto is_some_and(Pred &&pred) && -> bool
+    {
+        return is_some() && std::invoke(std::forward<Pred>(pred),
+                                        std::move(data_).value());
+    }
+
+    [[nodiscard]] constexpr auto has_value() const noexcept -> bool
+    {
+        return is_some();
+    }
+
+    constexpr explicit operator bool() const noexcept { return is_some(); }
+
+    // ======================================================================
+    // Extract the value
+    // ======================================================================
+
+    constexpr auto expect(const char *msg) const & -> T
+    {
+        if (is_none()) {
+            __detail::none_failed(msg);
+        }
+        return get();
+    }
+
+    constexpr auto expect(const char *msg) && -> T
+    {
+        if (is_none()) {
+            __detail::none_failed(msg);
+        }
+        return std::move(data_).value();
+    }
+
+    constexpr auto unwrap() const & -> T
+    {
+        return expect("called `Option::unwrap()` on a `None` value");
+    }
+
+    constexpr auto unwrap() && -> T
+    {
+        return std::move(*this).expect(
+            "called `Option::unwrap()` on a `None` value");
+    }
+
+    template <typename U>
+        requires std::is_convertible_v<U &&, T>
+    constexpr auto unwrap_or(U &&default_val) const & -> T
+    {
+        if (is_some()) {
+            return get();
+        }
+        return std::forward<U>(default_val);
+    }
+
+    template <typename U>
+        requires std::is_convertible_v<U &&, T>
+    constexpr auto unwrap_or(U &&default_val) && -> T
+    {
+        if (is_some()) {
+            return std::move(data_).value();
+        }
+        return std::forward<U>(default_val);
+    }
+
+    template <typename Fn>
+        requires std::is_convertible_v<std::invoke_result_t<Fn>, T>
+    constexpr auto unwrap_or_else(Fn &&fn) const & -> T
+    {
+        if (is_some()) {
+            return get();
+        }
+        return std::invoke(std::forward<Fn>(fn));
+    }
+
+    template <typename Fn>
+        requires std::is_convertible_v<std::invoke_result_t<Fn>, T>
+    constexpr auto unwrap_or_else(Fn &&fn) && -> T
+    {
+        if (is_some()) {
+            return std::move(data_).value();
+        }
+        return std::invoke(std::forward<Fn>(fn));
+    }
+
+    constexpr auto unwrap_or_default() const & -> T
+        requires is_default_constructible<T>
+    {
+        if (is_some()) {
+            return get();
+        }
+        return T{};
+    }
+
+    constexpr auto unwrap_or_default() && -> T
+        requires is_default_constructible<T>
+    {
+        if (is_some()) {
+            return std::move(data_).value();
+        }
+        return T{};
+    }
+
+    [[nodiscard]] constexpr auto unwrap_unchecked() & noexcept -> ref
+    {
+        assert(is_some() && "unwrap_unchecked() on a None Option");
+        return data_.value();
+    }
+
+    [[nodiscard]] constexpr auto unwrap_unchecked() const & noexcept -> cref
+    {
+        assert(is_some() && "unwrap_unchecked() on a None Option");
+        return get();
+    }
+
+    [[nodiscard]] constexpr auto unwrap_unchecked() && noexcept -> rref
+    {
+        assert(is_some() && "unwrap_unchecked() on a None Option");
+        return std::move(data_).value();
+    }
+
+    // std::optional spellings
+
+    [[nodiscard]] constexpr auto value() & -> ref
+    {
+        if (is_none()) {
+            __detail::none_failed("called `Option::value()` on a `None` value");
+        }
+        return data_.value();
+    }
+
+    [[nodiscard]] constexpr auto value() const & -> cref
+    {
+        if (is_none()) {
+            __detail::none_failed("called `Option::value()` on a `None` value");
+        }
+        return get();
+    }
+
+    [[nodiscard]] constexpr auto value() && -> rref
+    {
+        if (is_none()) {
+            __detail::none_failed("called `Option::value()` on a `None` value");
+        }
+        return std::move(data_).value();
+    }
+
+    [[nodiscard]] constexpr auto operator*() & noexcept -> ref
+    {
+        return unwrap_unchecked();
+    }
+
+    [[nodiscard]] constexpr auto operator*() const & noexcept -> cref
+    {
+        return unwrap_unchecked();
+    }
+
+    [[nodiscard]] constexpr auto operator*() && noexcept -> rref
+    {
+        return std::move(*this).unwrap_unchecked();
+    }
+
+    [[nodiscard]] constexpr auto operator->() noexcept
+    {
+        return std::addressof(unwrap_unchecked());
+    }
+
+    [[nodiscard]] constexpr auto operator->() const noexcept
+    {
+        return std::addressof(unwrap_unchecked());
+    }
+
+    template <typename U>
+        requires std::is_convertible_v<U &&, T>
+    [[nodiscard]] constexpr auto value_or(U &&default_val) const & -> T
+    {
+        return unwrap_or(std::forward<U>(default_val));
+    }
+
+    template <typename U>
+        requires std::is_convertible_v<U &&, T>
+    [[nodiscard]] constexpr auto value_or(U &&default_val) && -> T
+    {
+        return std::move(*this).unwrap_or(std::forward<U>(default_val));
+    }
+
+    constexpr operator std::optional<T>() const &
+        requires(!std::is_reference_v<T> && std::is_copy_constructible_v<T>)
+    {
+        if (is_some()) {
+            return std::optional<T>(get());
+        }
+        return std::nullopt;
+    }
+
+    constexpr operator std::optional<T>() &&
+        requires(!std::is_reference_v<T>)
+    {
+        if (is_some()) {
+            return std::optional<T>(std::move(data_).value());
+        }
+        return std::nullopt;
+    }
+
+    // ======================================================================
+    // Transforming the value
+    // ======================================================================
+
+    template <typename Fn>
+        requires(!std::is_void_v<std::invoke_result_t<Fn, cref>>)
+    constexpr auto map(Fn &&fn) const &
+        -> Option<std::invoke_result_t<Fn, cref>>
+    {
+        using Out = Option<std::invoke_result_t<Fn, cref>>;
+        if (is_some()) {
+            return Out(std::in_place, std::invoke(std::forward<Fn>(fn), get()));
+        }
+        return Out();
+    }
+
+    template <typename Fn>
+        requires(!std::is_void_v<std::invoke_result_t<Fn, T>>)
+    constexpr auto map(Fn &&fn) && -> Option<std::invoke_result_t<Fn, T>>
+    {
+        using Out = Option<std::invoke_result_t<Fn, T>>;
+        if (is_some()) {
+            return Out(std::in_place, std::invoke(std::forward<Fn>(fn),
+                                                  std::move(data_).value()));
+        }
+        return Out();
+    }
+
+    template <typename U, typename Fn>
+        requires std::is_convertible_v<std::invoke_result_t<Fn, cref>, U>
+    constexpr auto map_or(U default_val, Fn &&fn) const & -> U
+    {
+        if (is_some()) {
+            return std::invoke(std::forward<Fn>(fn), get());
+        }
+        return default_val;
+    }
+
+    template <typename U, typename Fn>
+        requires std::is_convertible_v<std::invoke_result_t<Fn, T>, U>
+    constexpr auto map_or(U default_val, Fn &&fn) && -> U
+    {
+        if (is_some()) {
+            return std::invoke(std::forward<Fn>(fn), std::move(data_).value());
+        }
+        return default_val;
+    }
+
+    template <typename Fn>
+        requires __detail::is_option_v<std::invoke_result_t<Fn, cref>>
+    constexpr auto and_then(Fn &&fn) const &
+    {
+        using Out = std::remove_cvref_t<std::invoke_result_t<Fn, cref>>;
+        if (is_some()) {
+            return std::invoke(std::forward<Fn>(fn), get());
+        }
+        return Out();
+    }
+
+    template <typename Fn>
+        requires __detail::is_option_v<std::invoke_result_t<Fn, T>>
+    constexpr auto and_then(Fn &&fn) &&
+    {
+        using Out = std::remove_cvref_t<std::invoke_result_t<Fn, T>>;
+        if (is_some()) {
+            return std::invoke(std::forward<Fn>(fn), std::move(data_).value());
+        }
+        return Out();
+    }
+
+    template <typename Pred>
+        requires fn_return_boolean<Pred, cref>
+    constexpr auto filter(Pred &&pred) const & -> Option
+    {
+        if (is_some() && std::invoke(std::forward<Pred>(pred), get())) {
+            return *this;
+        }
+        return Option();
+    }
+
+    template <typename Pred>
+        requires fn_return_boolean<Pred, cref>
+    constexpr auto filter(Pred &&pred) && -> Option
+    {
+        if (is_some() && std::invoke(std::forward<Pred>(pred), get())) {
+            return std::move(*this);
+        }
+        return Option();
+    }
+
+    constexpr auto or_(Option other) const & -> Option
+    {
+        return is_some() ? *this : std::move(other);
+    }
+
+    constexpr auto or_(Option other) && -> Option
+    {
+        return is_some() ? std::move(*this) : std::move(other);
+    }
+
+    template <typename Fn>
+        requires std::same_as<std::remove_cvref_t<std::invoke_result_t<Fn>>,
+                              Option>
+    constexpr auto or_else(Fn &&fn) const & -> Option
+    {
+        return is_some() ? *this : std::invoke(std::forward<Fn>(fn));
+    }
+
+    template <typename Fn>
+        requires std::same_as<std::remove_cvref_t<std::invoke_result_t<Fn>>,
+                              Option>
+    constexpr auto or_else(Fn &&fn) && -> Option
+    {
+        return is_some() ? std::move(*this) : std::invoke(std::forward<Fn>(fn));
+    }
+
+    // ======================================================================
+    // Conversion to Result
+    // ======================================================================
+
+    /**
+     * @brief Ok(value) for Some, Err(error) for None
+     */
+    template <typename E>
+    constexpr auto ok_or(E &&error RSTD_ERR_SITE_PARAM) const &
+        -> result::Result<T, std::decay_t<E>>
+    {
+        using Out = result::Result<T, std::decay_t<E>>;
+        if (is_some()) {
+            return Out::Ok(get());
+        }
+        return Out(result::ErrValue<std::decay_t<E>>{std::forward<E>(error),
+                                                     RSTD_ERR_SITE(site)});
+    }
+
+    template <typename E>
+    constexpr auto ok_or(E &&error RSTD_ERR_SITE_PARAM) &&
+        -> result::Result<T, std::decay_t<E>>
+    {
+        using Out = result::Result<T, std::decay_t<E>>;
+        if (is_some()) {
+            return Out::Ok(std::move(data_).value());
+        }
+        return Out(result::ErrValue<std::decay_t<E>>{std::forward<E>(error),
+                                                     RSTD_ERR_SITE(site)});
+    }
+
+    /**
+     * @brief Ok(value) for Some, Err(fn()) for None; fn runs only for None
+     */
+    template <typename Fn>
+    constexpr auto ok_or_else(Fn &&fn RSTD_ERR_SITE_PARAM) const &
+        -> result::Result<T, std::invoke_result_t<Fn>>
+    {
+        using G = std::invoke_result_t<Fn>;
+        using Out = result::Result<T, G>;
+        if (is_some()) {
+            return Out::Ok(get());
+        }
+        return Out(result::ErrValue<G>{std::invoke(std::forward<Fn>(fn)),
+                                       RSTD_ERR_SITE(site)});
+    }
+
+    template <typename Fn>
+    constexpr auto ok_or_else(Fn &&fn RSTD_ERR_SITE_PARAM) &&
+        -> result::Result<T, std::invoke_result_t<Fn>>
+    {
+        using G = std::invoke_result_t<Fn>;
+        using Out = result::Result<T, G>;
+        if (is_some()) {
+            return Out::Ok(std::move(data_).value());
+        }
+        return Out(result::ErrValue<G>{std::invoke(std::forward<Fn>(fn)),
+                                       RSTD_ERR_SITE(site)});
+    }
+
+    /**
+     * @brief Turn an Option of a Result inside out: None becomes Ok(None),
+     *        Some(Ok(v)) becomes Ok(Some(v)) and Some(Err(e)) becomes Err(e)
+     */
+    constexpr auto transpose() &&
+        requires result::__detail::is_result_v<T>
+    {
+        using parts = result::__detail::result_parts<T>;
+        using U = typename parts::value_type;
+        using Out = result::Result<Option<U>, typename parts::error_type>;
+        if (is_none()) {
+            return Out::Ok(Option<U>());
+        }
+        T &inner = data_.value();
+        if (inner.is_ok()) {
+            return Out::Ok(Option<U>(std::in_place,
+                                     std::move(inner).unwrap_unchecked()));
+        }
+        return Out(
+            result::__detail::try_access::propagate(std::move(inner)));
+    }
+
+    // ======================================================================
+    // In-place modification
+    // ======================================================================
+
+    /**
+     * @brief Move the value out, leaving None behind
+     */
+    constexpr auto take() -> Option
+    {
+        Option out = std::move(*this);
+        data_.reset();
+        return out;
+    }
+
+    template <typename... Args> constexpr auto emplace(Args &&...args) -> ref
+    {
+        return data_.emplace(std::forward<Args>(args)...);
+    }
+
+    constexpr auto reset() noexcept -> void { data_.reset(); }
+
+    // ======================================================================
+    // Comparison
+    // ======================================================================
+
+    [[nodiscard]] friend constexpr auto operator==(const Option &lhs,
+                                                   const Option &rhs) -> bool
+    {
+        if (lhs.is_some() && rhs.is_some()) {
+            return lhs.get() == rhs.get();
+        }
+        return lhs.is_some() == rhs.is_some();
+    }
+
+    [[nodiscard]] friend constexpr auto operator==(const Option &lhs,
+                                                   NoneType) noexcept -> bool
+    {
+        return lhs.is_none();
+    }
+
+    [[nodiscard]] friend constexpr auto operator==(const Option &lhs,
+                                                   std::nullopt_t) noexcept
+        -> bool
+    {
+        return lhs.is_none();
+    }
+
+    template <typename U>
+        requires(!__detail::is_option_v<U> &&
+                 !std::same_as<std::remove_cvref_t<U>, NoneType> &&
+                 !std::same_as<std::remove_cvref_t<U>, std::nullopt_t> &&
+                 std::equality_comparable_with<cref, const U &>)
+    [[nodiscard]] friend constexpr auto operator==(const Option &lhs,
+                                                   const U &rhs) -> bool
+    {
+        return lhs.is_some() && lhs.get() == rhs;
+    }
+
+    friend auto operator<<(std::ostream &os, const Option &opt)
+        -> std::ostream &
+        requires is_printable<std::remove_cvref_t<T>>
+    {
+        if (opt.is_none()) {
+            return os << "None";
+        }
+        return os << "Some(" << opt.get() << ")";
+    }
+
+private:
+    constexpr auto get() const noexcept -> cref { return data_.value(); }
+};
+
+/**
+ * @brief Some(value) with the Option type deduced from @p value
+ */
+template <typename T>
+[[nodiscard]] constexpr auto Some(T &&value) -> Option<std::decay_t<T>>
+{
+    return Option<std::decay_t<T>>(std::in_place, std::forward<T>(value));
+}
+
+/**
+ * @brief An Option relocates with memcpy when its value does
+ */
+template <typename T>
+struct is_trivially_relocatable<Option<T>>
+    : std::bool_constant<__detail::trivially_relocatable_pair<T, Void>>
+{};
+
+template <std::integral T>
+constexpr auto NonZero<T>::make(T value) noexcept -> Option<NonZero>
+{
+    if (value == 0) {
+        return Option<NonZero>();
+    }
+    return Option<NonZero>(std::in_place, value);
+}
+
+} // namespace rstd
@@ -0,0 +1,139 @@
+#pragma once
+
+#include <atomic>
+#include <cstddef>
+#include <cstdlib>
+#include <ostream>
+#include <stdexcept>
+#include <streambuf>
+
+#ifndef RSTD_PANIC_MESSAGE_CAPACITY
+#define RSTD_PANIC_MESSAGE_CAPACITY 4096
+#endif
+
+namespace rstd::panic
+{
+
+/**
+ * @brief Maximum length of a formatted panic message, including the NUL
+ *
+ * Longer messages are truncated. The default leaves room for an error
+ * printed with its backtrace; the buffer lives on the stack of the cold
+ * panic path only.
+ */
+inline constexpr std::size_t message_capacity = RSTD_PANIC_MESSAGE_CAPACITY;
+
+/**
+ * @brief Description of a panic, handed to the panic hook
+ *
+ * The message lives in a buffer on the panicking thread's stack and is only
+ * valid for the duration of the hook call.
+ */
+struct PanicInfo
+{
+    const char *message;
+    std::size_t length;
+    bool truncated;
+};
+
+using Hook = void (*)(const PanicInfo &info);
+
+/**
+ * @brief The hook installed at startup: throws std::runtime_error
+ */
+inline void default_hook(const PanicInfo &info)
+{
+    throw std::runtime_error(info.message);
+}
+
+namespace __detail
+{
+
+inline std::atomic<Hook> hook{&default_hook};
+
+using format_fn = void (*)(std::ostream &os, const void *value);
+
+template <typename V> void format_value(std::ostream &os, const void *value)
+{
+    os << *static_cast<const V *>(value);
+}
+
+/**
+ * @brief Stream buffer writing into a fixed array, dropping what overflows
+ */
+class fixed_buffer : public std::streambuf
+{
+    char data_[message_capacity];
+    bool truncated_ = false;
+
+protected:
+    auto overflow(int_type ch) -> int_type override
+    {
+        if (!traits_type::eq_int_type(ch, traits_type::eof())) {
+            truncated_ = true;
+        }
+        return traits_type::not_eof(ch);
+    }
+
+public:
+    fixed_buffer() { setp(data_, data_ + message_capacity - 1); }
+
+    auto finish() -> PanicInfo
+    {
+        *pptr() = '\0';
+        return PanicInfo{data_, static_cast<std::size_t>(pptr() - pbase()),
+                         truncated_};
+    }
+};
+
+/**
+ * @brief The single out-of-line panic routine shared by every Result
+ *
+ * Formats "msg: value" into a stack buffer without allocating and passes it
+ * to the current hook. @p format is null when the value is not printable.
+ * Aborts if the hook returns.
+ */
+[[noreturn, gnu::cold, gnu::noinline]] inline void
+begin_panic(const char *msg, const void *value, format_fn format)
+{
+    fixed_buffer buf;
+    {
+        std::ostream os(&buf);
+        os << msg;
+        if (format != nullptr) {
+            os << ": ";
+            format(os, value);
+        }
+    }
+    const PanicInfo info = buf.finish();
+    hook.load(std::memory_order_acquire)(info);
+    std::abort();
+}
+
+} // namespace __detail
+
+/**
+ * @brief Install a process-wide panic hook
+ *
+ * The hook runs on the panicking thread. It may throw to unwind, or
+ * terminate the process; if it returns, the process is aborted.
+ *
+ * @return the previously installed hook
+ */
+inline auto set_hook(Hook hook) noexcept -> Hook
+{
+    return __detail::hook.exchange(hook != nullptr ? hook : &default_hook,
+                                   std::memory_order_acq_rel);
+}
+
+/**
+ * @brief Restore the default hook
+ *
+ * @return the previously installed hook
+ */
+inline auto take_hook() noexcept -> Hook
+{
+    return __detail::hook.exchange(&default_hook, std::memory_order_acq_rel);
+}
+
+} // namespace rstd::panic
@@ -0,0 +1,509 @@
+#pragma once
+
+#include <algorithm>
+#include <atomic>
+#include <concepts>
+#include <condition_variable>
+#include <cstddef>
+#include <cstdint>
+#include <exception>
+#include <functional>
+#include <limits>
+#include <memory>
+#include <mutex>
+#include <optional>
+#include <ranges>
+#include <thread>
+#include <type_traits>
+#include <utility>
+#include <vector>
+
+#include "result.hpp"
+
+/**
+ * @file par.hpp
+ * @brief Parallel fail-fast algorithms over Result-returning functions
+ *
+ * @code
+ * auto parsed = rstd::par::try_transform(records, parse_record);
+ * // Result<std::vector<Parsed>, ParseError>
+ * @endcode
+ *
+ * The input is cut into chunks that the threads of a ThreadPool claim in
+ * index order. The first Err cancels every chunk that starts after it, and
+ * running chunks stop at their next element. Chunks before the failing
+ * index still complete, so the error returned is always the one at the
+ * lowest failing index, exactly as a sequential loop would report it.
+ */
+
+namespace rstd::par
+{
+
+/**
+ * @brief Fork-join thread pool: run() executes a job on every thread
+ *
+ * The thread calling run() takes part in the job, so a pool of size N
+ * starts N - 1 threads. Jobs from several callers are serialized; run()
+ * must not be called from inside a job.
+ */
+class ThreadPool
+{
+    using job_fn = void (*)(void *);
+
+    std::vector<std::thread> workers_;
+    std::mutex run_mutex_;
+    std::mutex mutex_;
+    std::condition_variable wake_;
+    std::condition_variable done_;
+    job_fn job_ = nullptr;
+    void *job_ctx_ = nullptr;
+    std::uint64_t generation_ = 0;
+    std::size_t pending_ = 0;
+    std::exception_ptr error_;
+    bool stop_ = false;
+
+    static auto invoke(job_fn job, void *ctx) noexcept -> std::exception_ptr
+    {
+        try {
+            job(ctx);
+        } catch (...) {
+            return std::current_exception();
+        }
+        return nullptr;
+    }
+
+    auto work() -> void
+    {
+        std::uint64_t seen = 0;
+        std::unique_lock lock(mutex_);
+        for (;;) {
+            wake_.wait(lock, [&] { return stop_ || generation_ != seen; });
+            if (stop_) {
+                return;
+            }
+            seen = generation_;
+            const job_fn job = job_;
+            void *const ctx = job_ctx_;
+
+            lock.unlock();
+            std::exception_ptr error = invoke(job, ctx);
+            lock.lock();
+
+            if (error && !error_) {
+                error_ = std::move(error);
+            }
+            if (--pending_ == 0) {
+                done_.notify_one();
+            }
+        }
+    }
+
+public:
+    /**
+     * @param threads number of threads taking part in each job, caller
+     *        included; 0 means one per hardware thread
+     */
+    explicit ThreadPool(unsigned threads = 0)
+    {
+        if (threads == 0) {
+            threads = std::max(1u, std::thread::hardware_concurrency());
+        }
+        workers_.reserve(threads - 1);
+        for (unsigned i = 1; i < threads; ++i) {
+            workers_.emplace_back([this] { work(); });
+        }
+    }
+
+    ThreadPool(const ThreadPool &) = delete;
+    auto operator=(const ThreadPool &) -> ThreadPool & = delete;
+
+    ~ThreadPool()
+    {
+        {
+            std::lock_guard lock(mutex_);
+            stop_ = true;
+        }
+        wake_.notify_all();
+        for (auto &t : workers_) {
+            t.join();
+        }
+    }
+
+    /**
+     * @brief Number of threads running each job, the caller included
+     */
+    [[nodiscard]] auto size() const noexcept -> std::size_t
+    {
+        return workers_.size() + 1;
+    }
+
+    /**
+     * @brief Call @p fn on every thread of the pool and wait for all of
+     *        them; the first exception thrown by any call is rethrown
+     */
+    template <typename Fn> auto run(Fn &fn) -> void
+    {
+        const job_fn job = [](void *ctx) { (*static_cast<Fn *>(ctx))(); };
+
+        std::lock_guard serial(run_mutex_);
+        {
+            std::lock_guard lock(mutex_);
+            job_ = job;
+            job_ctx_ = &fn;
+            pending_ = workers_.size();
+            error_ = nullptr;
+            ++generation_;
+        }
+        wake_.notify_all();
+
+        std::exception_ptr error = invoke(job, &fn);
+
+        std::unique_lock lock(mutex_);
+        done_.wait(lock, [&] { return pending_ == 0; });
+        if (!error) {
+            error = std::move(error_);
+        }
+        if (error) {
+            std::rethrow_exception(error);
+        }
+    }
+
+    /**
+     * @brief Pool used by the algorithms when none is given, with one
+     *        thread per hardware thread
+     */
+    static auto global() -> ThreadPool &
+    {
+        static ThreadPool pool;
+        return pool;
+    }
+};
+
+namespace __detail
+{
+
+/**
+ * @brief Chunk dispenser and lowest-index error shared by the threads of
+ *        one algorithm call
+ */
+template <typename E> class fail_fast
+{
+    static constexpr auto none = std::numeric_limits<std::size_t>::max();
+
+    std::size_t size_;
+    std::size_t grain_;
+    std::atomic<std::size_t> next_chunk_{0};
+    std::atomic<std::size_t> first_err_{none};
+    std::mutex err_mutex_;
+    std::optional<E> error_;
+
+public:
+    /**
+     * @param threads threads sharing the work; each gets about 16 chunks,
+     *        which bounds how much work runs past an error
+     */
+    fail_fast(std::size_t size, std::size_t threads)
+        : size_{size}, grain_{std::max<std::size_t>(1, size / (threads * 16))}
+    {}
+
+    [[nodiscard]] auto chunks() const noexcept -> std::size_t
+    {
+        return (size_ + grain_ - 1) / grain_;
+    }
+
+    /**
+     * @brief Claim the next chunk as [begin, end) and its number; false
+     *        once the input is exhausted or the chunk lies past an error
+     */
+    auto claim(std::size_t &chunk, std::size_t &begin, std::size_t &end)
+        -> bool
+    {
+        chunk = next_chunk_.fetch_add(1, std::memory_order_relaxed);
+        begin = chunk * grain_;
+        if (begin >= size_ || cancelled(begin)) {
+            return false;
+        }
+        end = std::min(size_, begin + grain_);
+        return true;
+    }
+
+    /**
+     * @brief Whether element @p i lies past a known error and can be
+     *        skipped
+     */
+    [[nodiscard]] auto cancelled(std::size_t i) const noexcept -> bool
+    {
+        return i > first_err_.load(std::memory_order_relaxed);
+    }
+
+    /**
+     * @brief Record that element @p i failed with @p error; the error with
+     *        the lowest index wins
+     */
+    auto fail(std::size_t i, E &&error) -> void
+    {
+        std::lock_guard lock(err_mutex_);
+        if (i < first_err_.load(std::memory_order_relaxed)) {
+            error_.emplace(std::move(error));
+            first_err_.store(i, std::memory_order_relaxed);
+        }
+    }
+
+    [[nodiscard]] auto failed() const noexcept -> bool
+    {
+        return error_.has_value();
+    }
+
+    [[nodiscard]] auto take_error() -> E { return std::move(*error_); }
+};
+
+constexpr auto to_offset(std::size_t i) noexcept -> std::ptrdiff_t
+{
+    return static_cast<std::ptrdiff_t>(i);
+}
+
+/**
+ * @brief Output of try_transform, written element by element by the workers
+ */
+template <typename U> class parallel_output
+{
+    std::vector<U> values_;
+
+public:
+    explicit parallel_output(std::size_t n) : values_(n) {}
+
+    auto operator[](std::size_t i) noexcept -> U & { return values_[i]; }
+
+    auto finish() && -> std::vector<U> { return std::move(values_); }
+};
+
+/**
+ * @brief std::vector<bool> packs neighbouring elements into one word, so
+ *        the workers write a plain array that is packed after the join
+ */
+template <> class parallel_output<bool>
+{
+    std::unique_ptr<bool[]> values_;
+    std::size_t size_;
+
+public:
+    explicit parallel_output(std::size_t n)
+        : values_{std::make_unique<bool[]>(n)}, size_{n}
+    {}
+
+    auto operator[](std::size_t i) noexcept -> bool & { return values_[i]; }
+
+    auto finish() && -> std::vector<bool>
+    {
+        return std::vector<bool>(values_.get(), values_.get() + size_);
+    }
+};
+
+/**
+ * @brief Run @p body(chunk, begin, end) over the chunks of [0, size) on
+ *        @p pool, stopping early once an element fails
+ */
+template <typename E, typename Body>
+auto run_chunks(ThreadPool &pool, fail_fast<E> &state, Body &&body) -> void
+{
+    auto job = [&] {
+        std::size_t chunk = 0;
+        std::size_t begin = 0;
+        std::size_t end = 0;
+        while (state.claim(chunk, begin, end)) {
+            body(chunk, begin, end);
+        }
+    };
+    pool.run(job);
+}
+
+template <typename Rng, typename Fn>
+using element_result_t = std::remove_cvref_t<
+    std::invoke_result_t<Fn &, std::ranges::range_reference_t<Rng>>>;
+
+/**
+ * @brief Random-access inputs and callables returning a Result for each
+ *        element
+ */
+template <typename Rng, typename Fn>
+concept result_callable =
+    std::ranges::random_access_range<Rng> && std::ranges::sized_range<Rng> &&
+    std::invocable<Fn &, std::ranges::range_reference_t<Rng>> &&
+    result::__detail::is_result_v<element_result_t<Rng, Fn>>;
+
+template <typename Rng, typename Fn>
+using element_parts = result::__detail::result_parts<element_result_t<Rng, Fn>>;
+
+template <typename Rng, typename Fn>
+using element_value_t = typename element_parts<Rng, Fn>::value_type;
+
+template <typename Rng, typename Fn>
+using element_error_t = typename element_parts<Rng, Fn>::error_type;
+
+} // namespace __detail
+
+// ==========================================================================
+// Algorithms
+// ==========================================================================
+
+/**
+ * @brief Apply @p fn to every element in parallel, collecting the values
+ *
+ * @return the values in input order, or the error of the lowest failing
+ *         element. The values must be default-constructible, since the
+ *         output is allocated before the threads fill it in.
+ */
+template <typename Rng, typename Fn>
+    requires __detail::result_callable<Rng, Fn> &&
+             std::default_initializable<__detail::element_value_t<Rng, Fn>>
+auto try_transform(ThreadPool &pool, Rng &&rng, Fn fn)
+    -> result::Result<std::vector<__detail::element_value_t<Rng, Fn>>,
+                      __detail::element_error_t<Rng, Fn>>
+{
+    using U = __detail::element_value_t<Rng, Fn>;
+    using E = __detail::element_error_t<Rng, Fn>;
+    using Out = result::Result<std::vector<U>, E>;
+
+    const auto first = std::ranges::begin(rng);
+    const auto n = static_cast<std::size_t>(std::ranges::size(rng));
+    __detail::parallel_output<U> out(n);
+    __detail::fail_fast<E> state(n, pool.size());
+
+    __detail::run_chunks(
+        pool, state, [&](std::size_t, std::size_t begin, std::size_t end) {
+            for (std::size_t i = begin; i < end && !state.cancelled(i); ++i) {
+                auto r = std::invoke(fn, first[__detail::to_offset(i)]);
+                if (r.is_err()) {
+                    state.fail(i, std::move(r).unwrap_err_unchecked());
+                    return;
+                }
+                out[i] = std::move(r).unwrap_unchecked();
+            }
+        });
+
+    if (state.failed()) {
+        return Out::Err(state.take_error());
+    }
+    return Out::Ok(std::move(out).finish());
+}
+
+template <typename Rng, typename Fn>
+    requires __detail::result_callable<Rng, Fn> &&
+             std::default_initializable<__detail::element_value_t<Rng, Fn>>
+auto try_transform(Rng &&rng, Fn fn)
+{
+    return try_transform(ThreadPool::global(), std::forward<Rng>(rng),
+                         std::move(fn));
+}
+
+/**
+ * @brief Call @p fn, which returns Result<void, E>, on every element in
+ *        parallel
+ *
+ * @return Ok, or the error of the lowest failing element
+ */
+template <typename Rng, typename Fn>
+    requires __detail::result_callable<Rng, Fn> &&
+             std::is_void_v<__detail::element_value_t<Rng, Fn>>
+auto try_for_each(ThreadPool &pool, Rng &&rng, Fn fn)
+    -> result::Result<void, __detail::element_error_t<Rng, Fn>>
+{
+    using E = __detail::element_error_t<Rng, Fn>;
+    using Out = result::Result<void, E>;
+
+    const auto first = std::ranges::begin(rng);
+    const auto n = static_cast<std::size_t>(std::ranges::size(rng));
+    __detail::fail_fast<E> state(n, pool.size());
+
+    __detail::run_chunks(
+        pool, state, [&](std::size_t, std::size_t begin, std::size_t end) {
+            for (std::size_t i = begin; i < end && !state.cancelled(i); ++i) {
+                auto r = std::invoke(fn, first[__detail::to_offset(i)]);
+                if (r.is_err()) {
+                    state.fail(i, std::move(r).unwrap_err_unchecked());
+                    return;
+                }
+            }
+        });
+
+    if (state.failed()) {
+        return Out::Err(state.take_error());
+    }
+    return Out::Ok();
+}
+
+template <typename Rng, typename Fn>
+    requires __detail::result_callable<Rng, Fn> &&
+             std::is_void_v<__detail::element_value_t<Rng, Fn>>
+auto try_for_each(Rng &&rng, Fn fn)
+{
+    return try_for_each(ThreadPool::global(), std::forward<Rng>(rng),
+                        std::move(fn));
+}
+
+/**
+ * @brief Map every element through @p fn in parallel and fold the values
+ *        with @p op, starting from @p init
+ *
+ * Each chunk is folded on its own and the partial results are then folded
+ * in chunk order, so @p op must be associative but need not be
+ * commutative.
+ *
+ * @return the folded value, or the error of the lowest failing element
+ */
+template <typename Rng, typename T, typename Op, typename Fn>
+    requires __detail::result_callable<Rng, Fn> &&
+             std::constructible_from<T, __detail::element_value_t<Rng, Fn>> &&
+             std::is_invocable_r_v<T, Op &, T, T>
+auto try_reduce(ThreadPool &pool, Rng &&rng, T init, Op op, Fn fn)
+    -> result::Result<T, __detail::element_error_t<Rng, Fn>>
+{
+    using E = __detail::element_error_t<Rng, Fn>;
+    using Out = result::Result<T, E>;
+
+    const auto first = std::ranges::begin(rng);
+    const auto n = static_cast<std::size_t>(std::ranges::size(rng));
+    __detail::fail_fast<E> state(n, pool.size());
+    std::vector<std::optional<T>> partials(state.chunks());
+
+    const auto body = [&](std::size_t chunk, std::size_t begin,
+                          std::size_t end) {
+        std::optional<T> &acc = partials[chunk];
+        for (std::size_t i = begin; i < end && !state.cancelled(i); ++i) {
+            auto r = std::invoke(fn, first[__detail::to_offset(i)]);
+            if (r.is_err()) {
+                state.fail(i, std::move(r).unwrap_err_unchecked());
+                return;
+            }
+            if (acc) {
+                *acc = std::invoke(op, std::move(*acc),
+                                   T(std::move(r).unwrap_unchecked()));
+            } else {
+                acc.emplace(std::move(r).unwrap_unchecked());
+            }
+        }
+    };
+    __detail::run_chunks(pool, state, body);
+
+    if (state.failed()) {
+        return Out::Err(state.take_error());
+    }
+    for (auto &partial : partials) {
+        if (partial) {
+            init = std::invoke(op, std::move(init), std::move(*partial));
+        }
+    }
+    return Out::Ok(std::move(init));
+}
+
+template <typename Rng, typename T, typename Op, typename Fn>
+    requires __detail::result_callable<Rng, Fn> &&
+             std::constructible_from<T, __detail::element_value_t<Rng, Fn>> &&
+             std::is_invocable_r_v<T, Op &, T, T>
+auto try_reduce(Rng &&rng, T init, Op op, Fn fn)
+{
+    return try_reduce(ThreadPool::global(), std::forward<Rng>(rng),
+                      std::move(init), std::move(op), std::move(fn));
+}
+
+} // namespace rstd::par
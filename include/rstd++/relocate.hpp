@@ -0,0 +1,178 @@
+#pragma once
+
+#include <cstddef>
+#include <cstring>
+#include <memory>
+#include <type_traits>
+#include <utility>
+
+/**
+ * @brief Marks a storage engine as passable in registers under Clang
+ *
+ * Clang silently drops the attribute from a template instantiation whose
+ * members are not themselves trivial for calls, so it only takes effect
+ * when every payload is trivially copyable or trivial_abi itself, e.g.
+ * std::unique_ptr under libc++'s trivial ABI.
+ */
+#if defined(__has_cpp_attribute)
+#if __has_cpp_attribute(clang::trivial_abi)
+#define RSTD_TRIVIAL_ABI [[clang::trivial_abi]]
+#endif
+#endif
+#ifndef RSTD_TRIVIAL_ABI
+#define RSTD_TRIVIAL_ABI
+#endif
+
+namespace rstd
+{
+
+/**
+ * @brief Customization point declaring that T can be moved with memcpy
+ *
+ * A type is trivially relocatable when moving an object to a new address
+ * and destroying the source is equivalent to copying its bytes and
+ * forgetting the source. That holds for every trivially copyable type and
+ * for most owning handles, which never point into themselves.
+ *
+ * The primary template covers trivially copyable types. Specialize it for
+ * a handle type that is relocatable in every standard library it is built
+ * with:
+ * @code
+ * template <>
+ * struct rstd::is_trivially_relocatable<Handle> : std::true_type
+ * {};
+ * @endcode
+ */
+template <typename T>
+struct is_trivially_relocatable
+    : std::bool_constant<std::is_trivially_copyable_v<T>>
+{};
+
+template <typename T, typename D>
+struct is_trivially_relocatable<std::unique_ptr<T, D>>
+    : is_trivially_relocatable<D>
+{};
+
+template <typename T>
+struct is_trivially_relocatable<std::shared_ptr<T>> : std::true_type
+{};
+
+template <typename T>
+struct is_trivially_relocatable<std::weak_ptr<T>> : std::true_type
+{};
+
+template <typename T>
+struct is_trivially_relocatable<std::default_delete<T>> : std::true_type
+{};
+
+template <typename T>
+inline constexpr bool is_trivially_relocatable_v =
+    is_trivially_relocatable<std::remove_cv_t<T>>::value;
+
+/**
+ * @brief Move [first, last) to the uninitialized range at @p dest and end
+ *        the lifetime of the source objects
+ *
+ * Trivially relocatable types are moved with a single memmove, so growing
+ * a buffer of Result<std::unique_ptr<T>, E> costs one copy of its bytes.
+ * Other types are move-constructed one by one and then destroyed. The
+ * ranges may overlap only when @p dest precedes @p first.
+ *
+ * @return one past the last relocated object in the destination
+ */
+template <typename T>
+    requires std::is_nothrow_move_constructible_v<T> ||
+             is_trivially_relocatable_v<T>
+auto relocate(T *first, T *last, T *dest) noexcept -> T *
+{
+    if constexpr (is_trivially_relocatable_v<T>) {
+        const auto count = static_cast<std::size_t>(last - first);
+        if (count != 0) {
+            std::memmove(static_cast<void *>(dest),
+                         static_cast<const void *>(first), count * sizeof(T));
+        }
+        return dest + count;
+    } else {
+        for (; first != last; ++first, ++dest) {
+            std::construct_at(dest, std::move(*first));
+            std::destroy_at(first);
+        }
+        return dest;
+    }
+}
+
+namespace __detail
+{
+
+/**
+ * @brief Untagged union of A and B whose owner tracks the active member
+ *
+ * Copy, move and destruction never touch the members: they are trivial
+ * when trivial for both A and B, and empty otherwise, leaving the owner
+ * to construct and destroy the active member itself. Unlike an anonymous
+ * union, whose special members are deleted as soon as one member has
+ * non-trivial ones, this keeps the union usable as a RSTD_TRIVIAL_ABI
+ * member.
+ */
+template <typename A, typename B> union RSTD_TRIVIAL_ABI raw_union
+{
+    A first;
+    B second;
+
+    constexpr raw_union() noexcept {}
+
+    template <typename... Args>
+    constexpr explicit raw_union(std::in_place_index_t<0>, Args &&...args)
+        : first(std::forward<Args>(args)...)
+    {}
+
+    template <typename... Args>
+    constexpr explicit raw_union(std::in_place_index_t<1>, Args &&...args)
+        : second(std::forward<Args>(args)...)
+    {}
+
+    constexpr raw_union(const raw_union &)
+        requires std::is_trivially_copy_constructible_v<A> &&
+                     std::is_trivially_copy_constructible_v<B>
+    = default;
+
+    constexpr raw_union(const raw_union &) noexcept {}
+
+    constexpr raw_union(raw_union &&)
+        requires std::is_trivially_move_constructible_v<A> &&
+                     std::is_trivially_move_constructible_v<B>
+    = default;
+
+    constexpr raw_union(raw_union &&) noexcept {}
+
+    constexpr auto operator=(const raw_union &) -> raw_union &
+        requires std::is_trivially_copy_assignable_v<A> &&
+                     std::is_trivially_copy_assignable_v<B>
+    = default;
+
+    constexpr auto operator=(const raw_union &) noexcept -> raw_union &
+    {
+        return *this;
+    }
+
+    constexpr auto operator=(raw_union &&) -> raw_union &
+        requires std::is_trivially_move_assignable_v<A> &&
+                     std::is_trivially_move_assignable_v<B>
+    = default;
+
+    constexpr auto operator=(raw_union &&) noexcept -> raw_union &
+    {
+        return *this;
+    }
+
+    constexpr ~raw_union()
+        requires std::is_trivially_destructible_v<A> &&
+                     std::is_trivially_destructible_v<B>
+    = default;
+
+    constexpr ~raw_union() {}
+};
+
+} // namespace __detail
+
+} // namespace rstd
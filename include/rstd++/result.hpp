@@ -1,212 +1,2110 @@
 #pragma once
 
-#include <optional>
-#include <sstream>
+#include <cstddef>
+#include <functional>
+#include <memory>
+#include <stdexcept>
 #include <type_traits>
 #include <utility>
-#include <variant>
-
+#include <version>
+
+#if defined(__cpp_lib_expected)
+#include <expected>
+#endif
+
+#ifndef RSTD_ERROR_LOCATIONS
+#define RSTD_ERROR_LOCATIONS 0
+#endif
+
+#if RSTD_ERROR_LOCATIONS
+#include <source_location>
+
+/**
+ * @brief Trailing parameter through which the Err factories capture their
+ *        call site
+ */
+#define RSTD_ERR_SITE_PARAM                                                    \
+    , ::std::source_location site = ::std::source_location::current()
+
+/**
+ * @brief The same parameter in a declaration that cannot repeat the default
+ */
+#define RSTD_ERR_SITE_DECL , ::std::source_location
+
+/**
+ * @brief Expands to @p site, or to nothing when locations are compiled out
+ */
+#define RSTD_ERR_SITE(site) site
+#else
+#define RSTD_ERR_SITE_PARAM
+#define RSTD_ERR_SITE_DECL
+#define RSTD_ERR_SITE(site)
+#endif
+
+#include "context.hpp"
 #include "core.hpp"
+#include "niche.hpp"
+#include "panic.hpp"
+#include "relocate.hpp"
+
+namespace rstd
+{
+
+template <typename T> class Option;
+
+} // namespace rstd
+
+namespace rstd::result
+{
+
+template <typename T, typename E> class Result;
+
+namespace __detail
+{
+
+struct OkTag
+{};
+
+/**
+ * @brief Selects the Err state; carries the call site that created the
+ *        error when RSTD_ERROR_LOCATIONS is enabled
+ */
+struct ErrTag
+{
+#if RSTD_ERROR_LOCATIONS
+    std::source_location site{};
+#endif
+};
+
+/**
+ * @brief A borrowed T, kept as a pointer so it can live in a union
+ */
+template <typename T> struct ref_box
+{
+    T *ptr;
+    constexpr ref_box(T &ref) noexcept : ptr{std::addressof(ref)} {}
+    ref_box(const T &&) = delete;
+};
+
+/**
+ * @brief Type actually stored for a Result parameter: references are boxed
+ */
+template <typename T> struct stored
+{
+    using type = T;
+};
+
+template <typename T> struct stored<T &>
+{
+    using type = ref_box<T>;
+};
+
+template <typename T> using stored_t = typename stored<T>::type;
+
+/**
+ * @brief Value type held by the storage of a Result<T, E>: Void for void
+ */
+template <typename T>
+using value_or_unit_t = std::conditional_t<std::is_void_v<T>, Void, T>;
+
+template <typename T> inline constexpr bool is_ref_box = false;
+
+template <typename T> inline constexpr bool is_ref_box<ref_box<T>> = true;
+
+} // namespace __detail
+
+} // namespace rstd::result
+
+namespace rstd
+{
+
+/**
+ * @brief A boxed reference is a pointer that is never misaligned, so it
+ *        shares the pointer niche
+ */
+template <typename T>
+    requires __detail::low_bit_free_pointee<T>
+struct niche_traits<result::__detail::ref_box<T>> : niche_traits<T *>
+{};
+
+} // namespace rstd
 
 namespace rstd::result
 {
 
-template <typename T, typename E> class Result;
+namespace __detail
+{
+
+template <typename T, std::size_t Offset = 0> struct value_type
+{
+    T value;
+    constexpr value_type(const T &d) : value{d} {}
+    constexpr value_type(T &&d) : value{std::move(d)} {}
+    template <typename... Args>
+    constexpr explicit value_type(std::in_place_t, Args &&...args) noexcept(
+        std::is_nothrow_constructible_v<T, Args...>)
+        : value(std::forward<Args>(args)...)
+    {}
+};
+
+template <typename E, std::size_t Offset = 0> struct error_type
+{
+    E error;
+    constexpr error_type(const E &e) : error{e} {}
+    constexpr error_type(E &&e) : error{std::move(e)} {}
+    template <typename... Args>
+    constexpr explicit error_type(std::in_place_t, Args &&...args) noexcept(
+        std::is_nothrow_constructible_v<E, Args...>)
+        : error(std::forward<Args>(args)...)
+    {}
+};
+
+/**
+ * @brief Value placed at a byte offset, used by niche-packed layouts
+ *
+ * The leading bytes overlap the niche pattern written into the error
+ * representation, so they are left uninitialized.
+ */
+template <typename T, std::size_t Offset>
+    requires(Offset > 0)
+struct value_type<T, Offset>
+{
+    std::byte niche_[Offset];
+    T value;
+    constexpr value_type(const T &d) : value{d} {}
+    constexpr value_type(T &&d) : value{std::move(d)} {}
+    template <typename... Args>
+    constexpr explicit value_type(std::in_place_t, Args &&...args) noexcept(
+        std::is_nothrow_constructible_v<T, Args...>)
+        : value(std::forward<Args>(args)...)
+    {}
+};
+
+/**
+ * @brief Error placed at a byte offset, used by niche-packed layouts
+ *
+ * The leading bytes overlap the niche pattern written into the value
+ * representation, so they are left uninitialized.
+ */
+template <typename E, std::size_t Offset>
+    requires(Offset > 0)
+struct error_type<E, Offset>
+{
+    std::byte niche_[Offset];
+    E error;
+    constexpr error_type(const E &e) : error{e} {}
+    constexpr error_type(E &&e) : error{std::move(e)} {}
+    template <typename... Args>
+    constexpr explicit error_type(std::in_place_t, Args &&...args) noexcept(
+        std::is_nothrow_constructible_v<E, Args...>)
+        : error(std::forward<Args>(args)...)
+    {}
+};
+
+template <typename T, typename E>
+concept copy_constructible_pair =
+    std::is_copy_constructible_v<T> && std::is_copy_constructible_v<E>;
+
+template <typename T, typename E>
+concept trivially_copy_constructible_pair =
+    copy_constructible_pair<T, E> &&
+    std::is_trivially_copy_constructible_v<T> &&
+    std::is_trivially_copy_constructible_v<E>;
+
+template <typename T, typename E>
+concept move_constructible_pair =
+    std::is_move_constructible_v<T> && std::is_move_constructible_v<E>;
+
+template <typename T, typename E>
+concept trivially_move_constructible_pair =
+    move_constructible_pair<T, E> &&
+    std::is_trivially_move_constructible_v<T> &&
+    std::is_trivially_move_constructible_v<E>;
+
+template <typename T, typename E>
+concept copy_assignable_pair =
+    copy_constructible_pair<T, E> && std::is_copy_assignable_v<T> &&
+    std::is_copy_assignable_v<E>;
+
+template <typename T, typename E>
+concept trivially_copy_assignable_pair =
+    copy_assignable_pair<T, E> && trivially_copy_constructible_pair<T, E> &&
+    std::is_trivially_copy_assignable_v<T> &&
+    std::is_trivially_copy_assignable_v<E> &&
+    std::is_trivially_destructible_v<T> && std::is_trivially_destructible_v<E>;
+
+template <typename T, typename E>
+concept move_assignable_pair =
+    move_constructible_pair<T, E> && std::is_move_assignable_v<T> &&
+    std::is_move_assignable_v<E>;
+
+template <typename T, typename E>
+concept trivially_move_assignable_pair =
+    move_assignable_pair<T, E> && trivially_move_constructible_pair<T, E> &&
+    std::is_trivially_move_assignable_v<T> &&
+    std::is_trivially_move_assignable_v<E> &&
+    std::is_trivially_destructible_v<T> && std::is_trivially_destructible_v<E>;
+
+template <typename T, typename E>
+concept trivially_destructible_pair =
+    std::is_trivially_destructible_v<T> && std::is_trivially_destructible_v<E>;
+
+template <typename T, typename E>
+concept trivially_relocatable_pair =
+    is_trivially_relocatable_v<stored_t<T>> &&
+    is_trivially_relocatable_v<stored_t<E>>;
+
+/**
+ * @brief Replace the active member @p old_val of a union with @p new_val
+ *
+ * Keeps the union holding a valid object if constructing @p new_val throws,
+ * either by building the new value aside first or by backing up the old one.
+ * Only a noexcept construction builds @p new_val directly in place.
+ * @p new_val and @p old_val may refer to the same member.
+ */
+template <typename New, typename Old, typename... Args>
+constexpr auto reinit(New &new_val, Old &old_val, Args &&...args) -> void
+{
+    if constexpr (std::is_nothrow_constructible_v<New, Args...>) {
+        std::destroy_at(std::addressof(old_val));
+        std::construct_at(std::addressof(new_val), std::forward<Args>(args)...);
+    } else if constexpr (std::is_nothrow_move_constructible_v<New>) {
+        New tmp(std::forward<Args>(args)...);
+        std::destroy_at(std::addressof(old_val));
+        std::construct_at(std::addressof(new_val), std::move(tmp));
+    } else {
+        static_assert(std::is_move_constructible_v<Old>,
+                      "replacing a non-movable payload requires a noexcept "
+                      "constructor");
+        Old backup(std::move(old_val));
+        std::destroy_at(std::addressof(old_val));
+        try {
+            std::construct_at(std::addressof(new_val),
+                              std::forward<Args>(args)...);
+        } catch (...) {
+            std::construct_at(std::addressof(old_val), std::move(backup));
+            throw;
+        }
+    }
+}
+
+/**
+ * @brief Where Guest fits in the niche payload of Owner, if anywhere
+ */
+template <typename Owner, typename Guest> struct niche_slot
+{
+    static constexpr bool fits = false;
+    static constexpr std::size_t offset = 0;
+};
+
+template <typename Owner, typename Guest>
+    requires niche_traits<Owner>::has_niche
+struct niche_slot<Owner, Guest>
+{
+private:
+    using traits = niche_traits<Owner>;
+
+    static constexpr std::size_t aligned_offset =
+        (traits::payload_offset + alignof(Guest) - 1) / alignof(Guest) *
+        alignof(Guest);
+
+public:
+    static constexpr bool fits =
+        alignof(Guest) <= alignof(Owner) &&
+        aligned_offset + sizeof(Guest) <=
+            traits::payload_offset + traits::payload_size;
+    static constexpr std::size_t offset = fits ? aligned_offset : 0;
+};
+
+/**
+ * @brief Decide whether one of T and E fits in the niche payload of the other
+ *
+ * The niche of T is tried first: the Err state is marked by it and the error
+ * lives at error_offset inside the free bytes of T. Failing that, the Ok
+ * state is marked by the niche of E and the value lives at value_offset.
+ * Either way no separate discriminant is stored.
+ */
+template <typename T, typename E> struct niche_layout
+{
+private:
+    using in_value = niche_slot<T, E>;
+    using in_error = niche_slot<E, T>;
+
+public:
+    static constexpr bool enabled = in_value::fits || in_error::fits;
+    static constexpr bool niche_in_error = !in_value::fits && in_error::fits;
+    static constexpr std::size_t value_offset =
+        niche_in_error ? in_error::offset : 0;
+    static constexpr std::size_t error_offset = in_value::offset;
+};
+
+struct no_discriminant
+{};
+
+/**
+ * @brief Tagged-union storage engine for Result<T, E>
+ *
+ * Holds either a value_type<T> or an error_type<E> in a union next to a
+ * discriminant. Copy, move and destruction are trivial whenever they are
+ * trivial for both T and E, so small results such as Result<int, ErrCode>
+ * keep the register-passing ABI of a plain struct. Under Clang the storage
+ * is also trivial_abi, which extends that ABI to payloads that are
+ * trivial_abi themselves.
+ *
+ * If niche_traits<T> exposes a niche whose payload can hold an E, the
+ * discriminant is dropped: the Err state is marked by the niche pattern and
+ * the error is stored in the free bytes of T. Otherwise the same is tried
+ * the other way round, with the niche of E marking the Ok state. Such
+ * layouts read the object representation and therefore cannot be used in
+ * constant evaluation.
+ *
+ * A reference parameter is stored as a ref_box, i.e. a single pointer.
+ */
+template <typename T, typename E> class RSTD_TRIVIAL_ABI storage
+{
+    using V = stored_t<T>;
+    using F = stored_t<E>;
+    using layout = niche_layout<V, F>;
+    static constexpr bool packed = layout::enabled;
+
+    rstd::__detail::raw_union<value_type<V, layout::value_offset>,
+                              error_type<F, layout::error_offset>>
+        payload_;
+    [[no_unique_address]] std::conditional_t<packed, no_discriminant, bool>
+        is_ok_;
+#if RSTD_ERROR_LOCATIONS
+    std::source_location site_{};
+#endif
+
+    auto repr() noexcept -> std::byte *
+    {
+        return reinterpret_cast<std::byte *>(std::addressof(payload_));
+    }
+
+    auto repr() const noexcept -> const std::byte *
+    {
+        return reinterpret_cast<const std::byte *>(std::addressof(payload_));
+    }
+
+    constexpr auto set_ok(bool ok) noexcept -> void
+    {
+        if constexpr (packed && layout::niche_in_error) {
+            if (ok) {
+                niche_traits<F>::set_niche(repr());
+            }
+        } else if constexpr (packed) {
+            if (!ok) {
+                niche_traits<V>::set_niche(repr());
+            }
+        } else {
+            is_ok_ = ok;
+        }
+    }
+
+    constexpr auto destroy() noexcept -> void
+    {
+        if (is_ok()) {
+            std::destroy_at(std::addressof(payload_.first));
+        } else {
+            std::destroy_at(std::addressof(payload_.second));
+        }
+    }
+
+    template <typename Other> constexpr auto assign(Other &&other) -> void
+    {
+#if RSTD_ERROR_LOCATIONS
+        site_ = other.site_;
+#endif
+        if (is_ok() && other.is_ok()) {
+            payload_.first = std::forward<Other>(other).payload_.first;
+        } else if (!is_ok() && !other.is_ok()) {
+            payload_.second = std::forward<Other>(other).payload_.second;
+        } else if (other.is_ok()) {
+            reinit(payload_.first, payload_.second,
+                   std::forward<Other>(other).payload_.first);
+            set_ok(true);
+        } else {
+            reinit(payload_.second, payload_.first,
+                   std::forward<Other>(other).payload_.second);
+            set_ok(false);
+        }
+    }
+
+    template <typename Other>
+    constexpr auto construct_from(Other &&other) -> void
+    {
+#if RSTD_ERROR_LOCATIONS
+        site_ = other.site_;
+#endif
+        if (other.is_ok()) {
+            std::construct_at(std::addressof(payload_.first),
+                              std::forward<Other>(other).payload_.first);
+            set_ok(true);
+        } else {
+            std::construct_at(std::addressof(payload_.second),
+                              std::forward<Other>(other).payload_.second);
+            set_ok(false);
+        }
+    }
+
+    template <typename U>
+    static constexpr auto unbox(U &stored) noexcept -> auto &
+    {
+        if constexpr (is_ref_box<std::remove_const_t<U>>) {
+            return *stored.ptr;
+        } else {
+            return stored;
+        }
+    }
+
+public:
+    template <typename... Args>
+    constexpr explicit storage(OkTag, Args &&...args)
+        : payload_(std::in_place_index<0>, std::forward<Args>(args)...)
+    {
+        set_ok(true);
+    }
+
+    template <typename... Args>
+    constexpr explicit storage([[maybe_unused]] ErrTag tag, Args &&...args)
+        : payload_(std::in_place_index<1>, std::forward<Args>(args)...)
+#if RSTD_ERROR_LOCATIONS
+          ,
+          site_{tag.site}
+#endif
+    {
+        set_ok(false);
+    }
+
+    constexpr storage(const storage &)
+        requires trivially_copy_constructible_pair<V, F>
+    = default;
+
+    constexpr storage(const storage &other) noexcept(
+        std::is_nothrow_copy_constructible_v<V> &&
+        std::is_nothrow_copy_constructible_v<F>)
+        requires copy_constructible_pair<V, F>
+    {
+        construct_from(other);
+    }
+
+    constexpr storage(storage &&)
+        requires trivially_move_constructible_pair<V, F>
+    = default;
+
+    constexpr storage(storage &&other) noexcept(
+        std::is_nothrow_move_constructible_v<V> &&
+        std::is_nothrow_move_constructible_v<F>)
+        requires move_constructible_pair<V, F>
+    {
+        construct_from(std::move(other));
+    }
+
+    constexpr auto operator=(const storage &) -> storage &
+        requires trivially_copy_assignable_pair<V, F>
+    = default;
+
+    constexpr auto operator=(const storage &other) -> storage &
+        requires copy_assignable_pair<V, F>
+    {
+        assign(other);
+        return *this;
+    }
+
+    constexpr auto operator=(storage &&) -> storage &
+        requires trivially_move_assignable_pair<V, F>
+    = default;
+
+    constexpr auto operator=(storage &&other) noexcept(
+        std::is_nothrow_move_constructible_v<V> &&
+        std::is_nothrow_move_assignable_v<V> &&
+        std::is_nothrow_move_constructible_v<F> &&
+        std::is_nothrow_move_assignable_v<F>) -> storage &
+        requires move_assignable_pair<V, F>
+    {
+        assign(std::move(other));
+        return *this;
+    }
+
+    constexpr ~storage()
+        requires trivially_destructible_pair<V, F>
+    = default;
+
+    constexpr ~storage() { destroy(); }
+
+    [[nodiscard]] constexpr auto is_ok() const noexcept -> bool
+    {
+        if constexpr (packed && layout::niche_in_error) {
+            return niche_traits<F>::is_niche(repr());
+        } else if constexpr (packed) {
+            return !niche_traits<V>::is_niche(repr());
+        } else {
+            return is_ok_;
+        }
+    }
+
+    [[nodiscard]] constexpr auto value() & noexcept -> T &
+    {
+        return unbox(payload_.first.value);
+    }
+
+    [[nodiscard]] constexpr auto value() const & noexcept -> const T &
+    {
+        return unbox(payload_.first.value);
+    }
+
+    [[nodiscard]] constexpr auto value() && noexcept -> T &&
+    {
+        return static_cast<T &&>(unbox(payload_.first.value));
+    }
+
+    [[nodiscard]] constexpr auto error() & noexcept -> E &
+    {
+        return unbox(payload_.second.error);
+    }
+
+    [[nodiscard]] constexpr auto error() const & noexcept -> const E &
+    {
+        return unbox(payload_.second.error);
+    }
+
+    [[nodiscard]] constexpr auto error() && noexcept -> E &&
+    {
+        return static_cast<E &&>(unbox(payload_.second.error));
+    }
+
+    template <typename... Args>
+    constexpr auto emplace_value(Args &&...args) -> T &
+    {
+        if (is_ok()) {
+            reinit(payload_.first, payload_.first,
+                   std::in_place, std::forward<Args>(args)...);
+        } else {
+            reinit(payload_.first, payload_.second,
+                   std::in_place, std::forward<Args>(args)...);
+            set_ok(true);
+        }
+        return value();
+    }
+
+    template <typename... Args>
+    constexpr auto emplace_error(Args &&...args) -> E &
+    {
+#if RSTD_ERROR_LOCATIONS
+        site_ = {};
+#endif
+        if (is_ok()) {
+            reinit(payload_.second, payload_.first,
+                   std::in_place, std::forward<Args>(args)...);
+            set_ok(false);
+        } else {
+            reinit(payload_.second, payload_.second,
+                   std::in_place, std::forward<Args>(args)...);
+        }
+        return error();
+    }
+
+    /**
+     * @brief Tag that builds another Result's error with this one's site
+     */
+    [[nodiscard]] constexpr auto err_tag() const noexcept -> ErrTag
+    {
+        return ErrTag{RSTD_ERR_SITE(site_)};
+    }
+
+#if RSTD_ERROR_LOCATIONS
+    [[nodiscard]] constexpr auto site() const noexcept -> std::source_location
+    {
+        return site_;
+    }
+#endif
+};
+
+/**
+ * @brief Reached when a Result panics during constant evaluation
+ *
+ * Deliberately not constexpr: an unwrap() of the wrong variant inside a
+ * constant expression becomes a compile error naming this function.
+ */
+[[noreturn]] inline void panic_in_constant_evaluation(const char *msg)
+{
+    throw std::runtime_error(msg);
+}
+
+/**
+ * @brief Panic with @p msg, printing @p value when it is printable
+ */
+template <typename V>
+    requires is_printable<V>
+[[noreturn]] constexpr void unwrap_failed(const char *msg, const V &value)
+{
+    if (std::is_constant_evaluated()) {
+        panic_in_constant_evaluation(msg);
+    }
+    panic::__detail::begin_panic(msg, std::addressof(value),
+                                 &panic::__detail::format_value<V>);
+}
+
+template <typename V>
+    requires(!is_printable<V>)
+[[noreturn]] [[deprecated(
+    "Use printable types or provide operator<< overload.")]] constexpr void
+unwrap_failed(const char *msg, [[maybe_unused]] const V &value)
+{
+    if (std::is_constant_evaluated()) {
+        panic_in_constant_evaluation(msg);
+    }
+    panic::__detail::begin_panic(msg, nullptr, nullptr);
+}
+
+/**
+ * @brief Error on its way out of a function through RSTD_TRY
+ *
+ * Holds a reference into the failed Result; the enclosing function's
+ * Result is built from it before that Result goes out of scope.
+ */
+template <typename Ref> struct propagated_error
+{
+    Ref &&error;
+#if RSTD_ERROR_LOCATIONS
+    std::source_location site;
+#endif
+};
+
+/**
+ * @brief Unchecked access used by the RSTD_TRY macros after their one
+ *        is_err() test
+ */
+struct try_access
+{
+    template <typename R>
+    static constexpr auto propagate(R &&r) noexcept
+        -> propagated_error<decltype(std::forward<R>(r).data_.error())>
+    {
+        return {std::forward<R>(r).data_.error(),
+                RSTD_ERR_SITE(r.data_.site())};
+    }
+
+    template <typename R>
+    static constexpr auto take_value(R &&r) noexcept
+        -> decltype(std::forward<R>(r).data_.value())
+    {
+        return std::forward<R>(r).data_.value();
+    }
+
+    /**
+     * @brief Build a Result from the storage a coroutine promise filled in
+     */
+    template <typename R, typename S>
+    static constexpr auto assemble(S &&data) -> R
+    {
+        return R(std::forward<S>(data));
+    }
+};
+
+template <typename> struct is_result_helper : std::false_type
+{};
+
+template <typename U, typename V>
+struct is_result_helper<Result<U, V>> : std::true_type
+{};
+
+template <typename T>
+concept is_result_v = is_result_helper<std::remove_cvref_t<T>>::value;
+
+template <typename> struct is_option_helper : std::false_type
+{};
+
+template <typename U> struct is_option_helper<Option<U>> : std::true_type
+{};
+
+template <typename T>
+concept is_option_v = is_option_helper<std::remove_cvref_t<T>>::value;
+
+/**
+ * @brief Value and error types of a Result
+ */
+template <typename R> struct result_parts;
+
+template <typename T, typename E> struct result_parts<Result<T, E>>
+{
+    using value_type = T;
+    using error_type = E;
+};
+
+/**
+ * @brief Wrap the outcome of @p fn in R::Ok, calling R::Ok() if it is void
+ */
+template <typename R, typename Fn, typename... Args>
+constexpr auto ok_from(Fn &&fn, Args &&...args) -> R
+{
+    if constexpr (std::is_void_v<std::invoke_result_t<Fn, Args...>>) {
+        std::invoke(std::forward<Fn>(fn), std::forward<Args>(args)...);
+        return R::Ok();
+    } else {
+        return R::Ok(
+            std::invoke(std::forward<Fn>(fn), std::forward<Args>(args)...));
+    }
+}
+
+} // namespace __detail
+
+// ======================================================================
+// Deduced Ok/Err wrappers
+// ======================================================================
+
+/**
+ * @brief An Ok payload whose error type is not known yet
+ *
+ * Returned by Ok(value) and converted into any Result<T, E> whose T can be
+ * constructed from it, like std::unexpected does for std::expected.
+ */
+template <typename T> struct OkValue
+{
+    T value;
+};
+
+template <> struct OkValue<void>
+{};
+
+/**
+ * @brief An Err payload whose value type is not known yet
+ *
+ * Returned by Err(error) and converted into any Result<T, E> whose E can be
+ * constructed from it.
+ */
+template <typename E> struct ErrValue
+{
+    E error;
+#if RSTD_ERROR_LOCATIONS
+    std::source_location site{};
+#endif
+};
+
+/**
+ * @brief Wrap @p value for conversion into a Result of any error type
+ *
+ * @code
+ * auto divide(int a, int b) -> Result<int, const char *>
+ * {
+ *     if (b == 0) {
+ *         return Err("Division by zero");
+ *     }
+ *     return Ok(a / b);
+ * }
+ * @endcode
+ */
+template <typename T>
+[[nodiscard]] constexpr auto Ok(T &&value) -> OkValue<std::decay_t<T>>
+{
+    return OkValue<std::decay_t<T>>{std::forward<T>(value)};
+}
+
+/**
+ * @brief Ok value for a Result<void, E> of any error type
+ */
+[[nodiscard]] constexpr auto Ok() noexcept -> OkValue<void> { return {}; }
+
+/**
+ * @brief Wrap @p error for conversion into a Result of any value type
+ */
+template <typename E>
+[[nodiscard]] constexpr auto
+Err(E &&error RSTD_ERR_SITE_PARAM) -> ErrValue<std::decay_t<E>>
+{
+    return ErrValue<std::decay_t<E>>{std::forward<E>(error),
+                                     RSTD_ERR_SITE(site)};
+}
+
+template <typename T, typename E>
+class [[nodiscard("Result must be used")]] Result
+{
+    __detail::storage<T, E> data_;
+
+    template <typename... Args>
+    constexpr explicit Result(__detail::OkTag tag, Args &&...args)
+        : data_{tag, std::forward<Args>(args)...}
+    {}
+
+    template <typename... Args>
+    constexpr explicit Result(__detail::ErrTag tag, Args &&...args)
+        : data_{tag, std::forward<Args>(args)...}
+    {}
+
+    constexpr explicit Result(__detail::storage<T, E> &&data)
+        : data_{std::move(data)}
+    {}
+
+    template <typename, typename> friend class Result;
+    friend struct __detail::try_access;
+
+public:
+    /**
+     * @brief Copy and move, each available, trivial and noexcept exactly
+     *        when it is for both payloads
+     */
+    constexpr Result(const Result &other) = default;
+    constexpr auto operator=(const Result &other) -> Result & = default;
+
+    constexpr Result(Result &&other) = default;
+    constexpr auto operator=(Result &&other) -> Result & = default;
+
+    /**
+     * @brief Receive an error propagated by RSTD_TRY, converting it to E
+     */
+    template <typename Ref>
+        requires std::is_constructible_v<E, Ref &&>
+    constexpr Result(__detail::propagated_error<Ref> propagated)
+        : data_{__detail::ErrTag{RSTD_ERR_SITE(propagated.site)},
+                std::forward<Ref>(propagated.error)}
+    {}
+
+    /**
+     * @brief Build an Ok Result from Ok(value), moving the payload into place
+     */
+    template <typename U>
+        requires std::is_constructible_v<T, U &&>
+    constexpr explicit(!std::is_convertible_v<U &&, T>)
+        Result(OkValue<U> &&ok)
+        : data_{__detail::OkTag{}, std::in_place, std::move(ok.value)}
+    {}
+
+    template <typename U>
+        requires std::is_constructible_v<T, const U &>
+    constexpr explicit(!std::is_convertible_v<const U &, T>)
+        Result(const OkValue<U> &ok)
+        : data_{__detail::OkTag{}, std::in_place, ok.value}
+    {}
+
+    /**
+     * @brief Build an Err Result from Err(error), moving the payload into
+     *        place
+     */
+    template <typename G>
+        requires std::is_constructible_v<E, G &&>
+    constexpr explicit(!std::is_convertible_v<G &&, E>)
+        Result(ErrValue<G> &&err)
+        : data_{__detail::ErrTag{RSTD_ERR_SITE(err.site)}, std::in_place,
+                std::move(err.error)}
+    {}
+
+    template <typename G>
+        requires std::is_constructible_v<E, const G &>
+    constexpr explicit(!std::is_convertible_v<const G &, E>)
+        Result(const ErrValue<G> &err)
+        : data_{__detail::ErrTag{RSTD_ERR_SITE(err.site)}, std::in_place,
+                err.error}
+    {}
+
+    // Friend declarations for factory functions
+    template <typename U, typename V>
+    friend constexpr auto Ok(const U &v) -> Result<U, V>;
+    template <typename U, typename V>
+    friend constexpr auto Ok(U &&v) -> Result<U, V>;
+    template <typename U, typename V>
+    friend constexpr auto Err(const V &e RSTD_ERR_SITE_DECL) -> Result<U, V>;
+    template <typename U, typename V>
+    friend constexpr auto Err(V &&e RSTD_ERR_SITE_DECL) -> Result<U, V>;
+
+    // ======================================================================
+    // Object creations
+    // ======================================================================
+
+    [[nodiscard("Result must be used")]] static constexpr auto
+    Ok(const T &value) -> Result
+    {
+        return Result(__detail::OkTag{}, value);
+    }
+
+    [[nodiscard("Result must be used")]] static constexpr auto
+    Ok(std::remove_reference_t<T> &&value) -> Result
+        requires(!std::is_reference_v<T>)
+    {
+        return Result(__detail::OkTag{}, std::move(value));
+    }
+
+    [[nodiscard("Result must be used")]] static constexpr auto
+    Err(const E &error RSTD_ERR_SITE_PARAM) -> Result
+    {
+        return Result(__detail::ErrTag{RSTD_ERR_SITE(site)}, error);
+    }
+
+    [[nodiscard("Result must be used")]] static constexpr auto
+    Err(std::remove_reference_t<E> &&error RSTD_ERR_SITE_PARAM) -> Result
+        requires(!std::is_reference_v<E>)
+    {
+        return Result(__detail::ErrTag{RSTD_ERR_SITE(site)}, std::move(error));
+    }
+
+    /**
+     * @brief Out-of-line Err factories for error paths
+     *
+     * Marked cold and never inlined, so the compiler treats the branch that
+     * builds the error as unlikely and keeps its code out of the hot path.
+     */
+    [[nodiscard("Result must be used"), gnu::cold, gnu::noinline]] static auto
+    ErrCold(const E &error RSTD_ERR_SITE_PARAM) -> Result
+    {
+        return Result(__detail::ErrTag{RSTD_ERR_SITE(site)}, error);
+    }
+
+    [[nodiscard("Result must be used"), gnu::cold, gnu::noinline]] static auto
+    ErrCold(std::remove_reference_t<E> &&error RSTD_ERR_SITE_PARAM) -> Result
+        requires(!std::is_reference_v<E>)
+    {
+        return Result(__detail::ErrTag{RSTD_ERR_SITE(site)}, std::move(error));
+    }
+
+    /**
+     * @brief Construct the Ok value in place from constructor arguments
+     *
+     * The payload is built directly in the Result's storage, and the
+     * returned prvalue is elided into its destination, so T is never moved
+     * and need not be movable.
+     */
+    template <typename... Args>
+        requires std::is_constructible_v<T, Args...>
+    [[nodiscard("Result must be used")]] static constexpr auto
+    Ok(std::in_place_t, Args &&...args) -> Result
+    {
+        return Result(__detail::OkTag{}, std::in_place,
+                      std::forward<Args>(args)...);
+    }
+
+    /**
+     * @brief Construct the Err value in place from constructor arguments
+     */
+    template <typename... Args>
+        requires std::is_constructible_v<E, Args...>
+    [[nodiscard("Result must be used")]] static constexpr auto
+    Err(std::in_place_t, Args &&...args) -> Result
+    {
+        return Result(__detail::ErrTag{}, std::in_place,
+                      std::forward<Args>(args)...);
+    }
+
+    // ======================================================================
+    // Replacing the contained values
+    // ======================================================================
+
+    /**
+     * @brief Destroy the current content and construct an Ok value in place
+     *
+     * If the constructor throws, the Result keeps its previous content. To
+     * allow that, a T whose constructor may throw is built aside and moved
+     * in; a noexcept constructor builds it directly in place.
+     *
+     * @return reference to the new value
+     */
+    template <typename... Args>
+        requires std::is_constructible_v<T, Args...>
+    constexpr auto emplace_ok(Args &&...args) -> T &
+    {
+        return data_.emplace_value(std::forward<Args>(args)...);
+    }
+
+    /**
+     * @brief Destroy the current content and construct an Err value in place
+     *
+     * If the constructor throws, the Result keeps its previous content.
+     *
+     * @return reference to the new error
+     */
+    template <typename... Args>
+        requires std::is_constructible_v<E, Args...>
+    constexpr auto emplace_err(Args &&...args) -> E &
+    {
+        return data_.emplace_error(std::forward<Args>(args)...);
+    }
+
+    // ======================================================================
+    // Querying the contained values
+    // ======================================================================
+
+    [[nodiscard]] constexpr auto is_ok() const -> bool
+    {
+        return data_.is_ok();
+    }
+
+    template <typename Pred>
+        requires fn_return_boolean<Pred, T>
+    [[nodiscard]] constexpr auto is_ok_and(Pred &&pred) const & -> bool
+    {
+        return is_ok() && std::forward<Pred>(pred)(data_.value());
+    }
+
+    template <typename Pred>
+        requires fn_return_boolean<Pred, T>
+    [[nodiscard]] constexpr auto is_ok_and(Pred &&pred) && -> bool
+    {
+        return is_ok() && std::forward<Pred>(pred)(std::move(data_).value());
+    }
+
+    [[nodiscard]] constexpr auto is_err() const -> bool
+    {
+        return !data_.is_ok();
+    }
+
+    template <typename Pred>
+        requires fn_return_boolean<Pred, E>
+    [[nodiscard]] constexpr auto is_err_and(Pred &&pred) const & -> bool
+    {
+        return is_err() && std::forward<Pred>(pred)(data_.error());
+    }
+
+    template <typename Pred>
+        requires fn_return_boolean<Pred, E>
+    [[nodiscard]] constexpr auto is_err_and(Pred &&pred) && -> bool
+    {
+        return is_err() && std::forward<Pred>(pred)(std::move(data_).error());
+    }
+
+#if RSTD_ERROR_LOCATIONS
+    /**
+     * @brief Call site of the Err factory that created the error
+     *
+     * Combinators, RSTD_TRY and co_await pass it along with the error. An
+     * Ok, or an error built in place, has a default-constructed location.
+     * Only available when compiled with RSTD_ERROR_LOCATIONS.
+     */
+    [[nodiscard]] constexpr auto error_location() const noexcept
+        -> std::source_location
+    {
+        return data_.site();
+    }
+#endif
+
+    // ======================================================================
+    // Borrowing the contained values
+    // ======================================================================
+
+    /**
+     * @brief Borrow the value or the error without copying it
+     */
+    [[nodiscard]] constexpr auto as_ref() const &
+        -> Result<const T &, const E &>
+    {
+        if (is_ok()) {
+            return Result<const T &, const E &>(__detail::OkTag{},
+                                                data_.value());
+        }
+        return Result<const T &, const E &>(data_.err_tag(), data_.error());
+    }
+
+    /**
+     * @brief Mutably borrow the value or the error
+     */
+    [[nodiscard]] constexpr auto as_mut() & -> Result<T &, E &>
+    {
+        if (is_ok()) {
+            return Result<T &, E &>(__detail::OkTag{}, data_.value());
+        }
+        return Result<T &, E &>(data_.err_tag(), data_.error());
+    }
+
+    auto as_ref() const && -> Result<const T &, const E &> = delete;
+    auto as_mut() && -> Result<T &, E &> = delete;
+
+    /**
+     * @brief Reference to the Ok value; panics on Err
+     */
+    [[nodiscard]] constexpr auto value() & -> T &
+    {
+        if (is_err()) {
+            const E &e = data_.error();
+            __detail::unwrap_failed(
+                "called `Result::value()` on an `Err` value", e);
+        }
+        return data_.value();
+    }
+
+    [[nodiscard]] constexpr auto value() const & -> const T &
+    {
+        if (is_err()) {
+            const E &e = data_.error();
+            __detail::unwrap_failed(
+                "called `Result::value()` on an `Err` value", e);
+        }
+        return data_.value();
+    }
+
+    [[nodiscard]] constexpr auto value() && -> T &&
+    {
+        if (is_err()) {
+            const E &e = data_.error();
+            __detail::unwrap_failed(
+                "called `Result::value()` on an `Err` value", e);
+        }
+        return std::move(data_).value();
+    }
+
+    /**
+     * @brief Reference to the Err value; panics on Ok
+     */
+    [[nodiscard]] constexpr auto error() & -> E &
+    {
+        if (is_ok()) {
+            const T &v = data_.value();
+            __detail::unwrap_failed(
+                "called `Result::error()` on an `Ok` value", v);
+        }
+        return data_.error();
+    }
+
+    [[nodiscard]] constexpr auto error() const & -> const E &
+    {
+        if (is_ok()) {
+            const T &v = data_.value();
+            __detail::unwrap_failed(
+                "called `Result::error()` on an `Ok` value", v);
+        }
+        return data_.error();
+    }
+
+    [[nodiscard]] constexpr auto error() && -> E &&
+    {
+        if (is_ok()) {
+            const T &v = data_.value();
+            __detail::unwrap_failed(
+                "called `Result::error()` on an `Ok` value", v);
+        }
+        return std::move(data_).error();
+    }
+
+    /**
+     * @brief The Ok value, without checking the discriminant
+     *
+     * For callers that have already tested is_ok(). Calling this on an Err
+     * is undefined behavior.
+     */
+    [[nodiscard]] constexpr auto unwrap_unchecked() & noexcept -> T &
+    {
+        return data_.value();
+    }
+
+    [[nodiscard]] constexpr auto unwrap_unchecked() const & noexcept
+        -> const T &
+    {
+        return data_.value();
+    }
+
+    [[nodiscard]] constexpr auto unwrap_unchecked() && noexcept(
+        std::is_nothrow_move_constructible_v<T>) -> T
+    {
+        return std::move(data_).value();
+    }
+
+    /**
+     * @brief The Err value, without checking the discriminant
+     *
+     * For callers that have already tested is_err(). Calling this on an Ok
+     * is undefined behavior.
+     */
+    [[nodiscard]] constexpr auto unwrap_err_unchecked() & noexcept -> E &
+    {
+        return data_.error();
+    }
+
+    [[nodiscard]] constexpr auto unwrap_err_unchecked() const & noexcept
+        -> const E &
+    {
+        return data_.error();
+    }
+
+    [[nodiscard]] constexpr auto unwrap_err_unchecked() && noexcept(
+        std::is_nothrow_move_constructible_v<E>) -> E
+    {
+        return std::move(data_).error();
+    }
+
+    // ======================================================================
+    // Adapter for each variant
+    // ======================================================================
+
+    /**
+     * @brief The Ok value as an Option; an rvalue Result moves it out
+     */
+    [[nodiscard]] constexpr auto ok() const & -> Option<T>
+    {
+        if (is_ok()) {
+            return Option<T>(std::in_place, data_.value());
+        }
+        return Option<T>();
+    }
+
+    [[nodiscard]] constexpr auto ok() && -> Option<T>
+    {
+        if (is_ok()) {
+            return Option<T>(std::in_place, std::move(data_).value());
+        }
+        return Option<T>();
+    }
+
+    /**
+     * @brief The error as an Option; an rvalue Result moves it out
+     */
+    [[nodiscard]] constexpr auto err() const & -> Option<E>
+    {
+        if (is_err()) {
+            return Option<E>(std::in_place, data_.error());
+        }
+        return Option<E>();
+    }
+
+    [[nodiscard]] constexpr auto err() && -> Option<E>
+    {
+        if (is_err()) {
+            return Option<E>(std::in_place, std::move(data_).error());
+        }
+        return Option<E>();
+    }
+
+    /**
+     * @brief Turn a Result of an Option inside out: Ok(None) becomes None,
+     *        Ok(Some(v)) becomes Some(Ok(v)) and Err(e) becomes Some(Err(e))
+     */
+    constexpr auto transpose() &&
+        requires __detail::is_option_v<T>
+    {
+        using U = typename T::value_type;
+        using Out = Option<Result<U, E>>;
+        if (is_err()) {
+            return Out(std::in_place,
+                       __detail::try_access::propagate(std::move(*this)));
+        }
+        T &inner = data_.value();
+        if (inner.is_none()) {
+            return Out();
+        }
+        return Out(std::in_place,
+                   OkValue<U>{std::move(inner).unwrap_unchecked()});
+    }
+
+    // ======================================================================
+    // Transforming contained values
+    // ======================================================================
+
+    template <typename FnOk>
+    constexpr auto
+    map(FnOk &&fn) const & -> Result<std::invoke_result_t<FnOk, T>, E>
+    {
+        using U = std::invoke_result_t<FnOk, T>;
+        if (is_ok()) {
+            return __detail::ok_from<Result<U, E>>(std::forward<FnOk>(fn),
+                                                   data_.value());
+        }
+        return Result<U, E>(data_.err_tag(), data_.error());
+    }
+
+    template <typename FnOk>
+    constexpr auto map(FnOk &&fn) && -> Result<std::invoke_result_t<FnOk, T>, E>
+    {
+        using U = std::invoke_result_t<FnOk, T>;
+        if (is_ok()) {
+            return __detail::ok_from<Result<U, E>>(std::forward<FnOk>(fn),
+                                                   std::move(data_).value());
+        }
+        return Result<U, E>(data_.err_tag(), std::move(data_).error());
+    }
+
+    template <typename U, typename FnOk>
+        requires std::is_same_v<U, std::invoke_result_t<FnOk, T>>
+    constexpr auto map_or(const U &default_val, FnOk &&fn) const & -> U
+    {
+        if (is_ok()) {
+            return std::forward<FnOk>(fn)(data_.value());
+        }
+        return default_val;
+    }
+
+    template <typename U, typename FnMap>
+        requires std::is_same_v<U, std::invoke_result_t<FnMap, T>>
+    constexpr auto map_or(const U &default_val, FnMap &&fn) && -> U
+    {
+        if (is_ok()) {
+            return std::forward<FnMap>(fn)(std::forward<T>(
+                std::move(data_).value()));
+        }
+        return default_val;
+    }
+
+    template <typename FnErr, typename FnOk>
+        requires std::is_same_v<std::invoke_result_t<FnErr, E>,
+                                std::invoke_result_t<FnOk, T>>
+    constexpr auto
+    map_or_else(FnErr &&fn_err,
+                FnOk &&fn_ok) const & -> std::invoke_result_t<FnOk, T>
+    {
+        if (is_ok()) {
+            return std::forward<FnOk>(fn_ok)(data_.value());
+        }
+        return std::forward<FnErr>(fn_err)(data_.error());
+    }
+
+    template <typename FnErr, typename FnOk>
+        requires std::is_same_v<std::invoke_result_t<FnErr, E>,
+                                std::invoke_result_t<FnOk, T>>
+    constexpr auto map_or_else(FnErr &&fn_err,
+                               FnOk &&fn_ok) && -> std::invoke_result_t<FnOk, T>
+    {
+        if (is_ok()) {
+            return std::forward<FnOk>(fn_ok)(std::move(data_).value());
+        }
+        return std::forward<FnErr>(fn_err)(std::move(data_).error());
+    }
+
+    template <typename FnErr>
+    constexpr auto
+    map_err(FnErr &&fn) const & -> Result<T, std::invoke_result_t<FnErr, E>>
+    {
+        using V = std::invoke_result_t<FnErr, E>;
+        if (is_err()) {
+            return Result<T, V>(data_.err_tag(),
+                                std::forward<FnErr>(fn)(data_.error()));
+        }
+        return Result<T, V>::Ok(data_.value());
+    }
+
+    template <typename FnErr>
+    constexpr auto
+    map_err(FnErr &&fn) && -> Result<T, std::invoke_result_t<FnErr, E>>
+    {
+        using V = std::invoke_result_t<FnErr, E>;
+        if (is_err()) {
+            return Result<T, V>(
+                data_.err_tag(),
+                std::forward<FnErr>(fn)(std::move(data_).error()));
+        }
+        return Result<T, V>::Ok(std::move(data_).value());
+    }
+
+    template <typename Fn>
+        requires fn_return_void<Fn, T>
+    constexpr auto inspect(Fn &&fn) const & -> const Result &
+    {
+        if (is_ok()) {
+            std::forward<Fn>(fn)(data_.value());
+        }
+        return *this;
+    }
+
+    template <typename Fn>
+        requires fn_return_void<Fn, T>
+    constexpr auto inspect(Fn &&fn) && -> Result &&
+    {
+        if (is_ok()) {
+            std::forward<Fn>(fn)(std::move(data_).value());
+        }
+        return std::move(*this);
+    }
+
+    template <typename Fn>
+        requires fn_return_void<Fn, E>
+    constexpr auto inspect_err(Fn &&fn) const & -> const Result &
+    {
+        if (is_err()) {
+            std::forward<Fn>(fn)(data_.error());
+        }
+        return *this;
+    }
+
+    template <typename Fn>
+        requires fn_return_void<Fn, E>
+    constexpr auto inspect_err(Fn &&fn) && -> Result &&
+    {
+        if (is_err()) {
+            std::forward<Fn>(fn)(std::move(data_).error());
+        }
+        return std::move(*this);
+    }
+
+    // ======================================================================
+    // Attaching context to the error
+    // ======================================================================
+
+    /**
+     * @brief Add @p msg, and at most one small @p arg, as context to the
+     *        error
+     *
+     * @p msg must outlive the error, as a string literal does. Nothing is
+     * formatted or allocated here; see context.hpp.
+     */
+    template <typename... Args>
+        requires(sizeof...(Args) <= 1 && (context_arg<Args> && ...))
+    auto context(const char *msg,
+                 Args... arg) const & -> Result<T, context_t<E>>
+    {
+        using R = Result<T, context_t<E>>;
+        if (is_ok()) {
+            return R::Ok(data_.value());
+        }
+        auto res = R(data_.err_tag(), std::in_place, data_.error());
+        res.data_.error().push(ContextFrame(msg, arg...));
+        return res;
+    }
+
+    template <typename... Args>
+        requires(sizeof...(Args) <= 1 && (context_arg<Args> && ...))
+    auto context(const char *msg, Args... arg) && -> Result<T, context_t<E>>
+    {
+        using R = Result<T, context_t<E>>;
+        if (is_ok()) {
+            return R::Ok(std::move(data_).value());
+        }
+        auto res = R(data_.err_tag(), std::in_place, std::move(data_).error());
+        res.data_.error().push(ContextFrame(msg, arg...));
+        return res;
+    }
+
+    // ======================================================================
+    // Extract a value
+    // ======================================================================
+
+    constexpr auto expect(const char *msg) const & -> T
+    {
+        if (is_ok()) {
+            return data_.value();
+        }
+        const E &e = data_.error();
+        __detail::unwrap_failed(msg, e);
+    }
+
+    constexpr auto expect(const char *msg) && -> T
+    {
+        if (is_ok()) {
+            return std::move(data_).value();
+        }
+        const E &e = data_.error();
+        __detail::unwrap_failed(msg, e);
+    }
+
+    constexpr auto unwrap() const & -> T
+    {
+        if (is_ok()) {
+            return data_.value();
+        }
+        const E &e = data_.error();
+        __detail::unwrap_failed(
+            "called `Result::unwrap()` on an `Err` value", e);
+    }
+
+    constexpr auto unwrap() && -> T
+    {
+        if (is_ok()) {
+            return std::move(data_).value();
+        }
+        const E &e = data_.error();
+        __detail::unwrap_failed(
+            "called `Result::unwrap()` on an `Err` value", e);
+    }
+
+    constexpr auto unwrap_or_default() const & -> T
+        requires is_default_constructible<T>
+    {
+        if (is_ok()) {
+            return data_.value();
+        }
+        return T{};
+    }
+
+    constexpr auto unwrap_or_default() && -> T
+        requires is_default_constructible<T>
+    {
+        if (is_ok()) {
+            return std::move(data_).value();
+        }
+        return T{};
+    }
+
+    constexpr auto expect_err(const char *msg) const & -> E
+    {
+        if (is_err()) {
+            return data_.error();
+        }
+        const T &v = data_.value();
+        __detail::unwrap_failed(msg, v);
+    }
+
+    constexpr auto expect_err(const char *msg) && -> E
+    {
+        if (is_err()) {
+            return std::move(data_).error();
+        }
+        const T &v = data_.value();
+        __detail::unwrap_failed(msg, v);
+    }
+
+    constexpr auto unwrap_err() const & -> E
+    {
+        if (is_err()) {
+            return data_.error();
+        }
+        const T &v = data_.value();
+        __detail::unwrap_failed(
+            "called `Result::unwrap_err()` on an `Ok` value", v);
+    }
+
+    constexpr auto unwrap_err() && -> E
+    {
+        if (is_err()) {
+            return std::move(data_).error();
+        }
+        const T &v = data_.value();
+        __detail::unwrap_failed(
+            "called `Result::unwrap_err()` on an `Ok` value", v);
+    }
+
+    template <typename U>
+    constexpr auto and_(Result<U, E> &res) const & -> Result<U, E>
+    {
+        if (is_ok()) {
+            return res;
+        }
+        return Result<U, E>(data_.err_tag(), data_.error());
+    }
+
+    template <typename U>
+    constexpr auto and_(Result<U, E> &&res) const & -> Result<U, E>
+    {
+        if (is_ok()) {
+            return std::forward<Result<U, E>>(res);
+        }
+        return Result<U, E>(data_.err_tag(), data_.error());
+    }
+
+    template <typename U>
+    constexpr auto and_(Result<U, E> &&res) && -> Result<U, E>
+    {
+        if (is_ok()) {
+            return std::forward<Result<U, E>>(res);
+        }
+        return Result<U, E>(data_.err_tag(), std::move(data_).error());
+    }
+
+    template <typename Fn>
+        requires __detail::is_result_v<std::invoke_result_t<Fn, T>>
+    constexpr auto and_then(Fn &&fn) const &
+    {
+        using Ret = std::invoke_result_t<Fn, T>;
+        if (is_ok()) {
+            return std::forward<Fn>(fn)(data_.value());
+        }
+        return Ret(data_.err_tag(), data_.error());
+    }
+
+    template <typename Fn>
+        requires __detail::is_result_v<std::invoke_result_t<Fn, T>>
+    constexpr auto and_then(Fn &&fn) &&
+    {
+        using Ret = std::invoke_result_t<Fn, T>;
+        if (is_ok()) {
+            return std::forward<Fn>(fn)(std::move(data_).value());
+        }
+        return Ret(data_.err_tag(), std::move(data_).error());
+    }
+
+    constexpr auto or_(const Result<T, E> &res) const & -> Result<T, E>
+    {
+        if (is_ok()) {
+            return Result<T, E>::Ok(data_.value());
+        }
+        return res;
+    }
+
+    constexpr auto or_(Result<T, E> &&res) const & -> Result<T, E>
+    {
+        if (is_ok()) {
+            return Result<T, E>::Ok(data_.value());
+        }
+        return std::forward<Result<T, E>>(res);
+    }
+
+    constexpr auto or_(Result<T, E> &&res) && -> Result<T, E>
+    {
+        if (is_ok()) {
+            return Result<T, E>::Ok(std::move(data_).value());
+        }
+        return std::forward<Result<T, E>>(res);
+    }
+
+    template <typename Fn>
+        requires __detail::is_result_v<std::invoke_result_t<Fn, E>>
+    constexpr auto or_else(Fn &&fn) const &
+    {
+        using Ret = std::invoke_result_t<Fn, E>;
+        if (is_ok()) {
+            return Ret::Ok(data_.value());
+        }
+
+        return std::forward<Fn>(fn)(data_.error());
+    }
+
+    template <typename Fn>
+        requires __detail::is_result_v<std::invoke_result_t<Fn, E>>
+    constexpr auto or_else(Fn &&fn) &&
+    {
+        using Ret = std::invoke_result_t<Fn, E>;
+        if (is_ok()) {
+            return Ret::Ok(std::move(data_).value());
+        }
+
+        return std::forward<Fn>(fn)(std::move(data_).error());
+    }
+
+    // ======================================================================
+    // Impl Clone for Result
+    // ======================================================================
+
+    constexpr auto clone() const & -> Result
+        requires(is_cloneable<T> && is_cloneable<E>)
+    {
+        return Result(*this);
+    }
+
+    [[deprecated("Cloning an rvalue Result is unnecessary. Use std::move() or "
+                 "just assign the rvalue directly.")]] constexpr auto
+    clone() && -> Result
+        requires(is_cloneable<T> && is_cloneable<E>)
+    {
+        return std::move(*this);
+    }
+
+    constexpr auto clone_from(const Result &other) -> void
+        requires(is_cloneable<T> && is_cloneable<E>)
+    {
+        if (this == &other) {
+            return;
+        }
+        data_ = other.data_;
+    }
+
+    [[deprecated(
+        "clone_from() with rvalue is inefficient. Use move_from() for moving "
+        "from rvalues, or clone_from(const Result&) for copying.")]]
+    constexpr auto clone_from(Result &&other) -> void
+        requires(is_cloneable<T> && is_cloneable<E>)
+    {
+        if (this == &other) {
+            return;
+        }
+        data_ = std::move(other.data_);
+    }
+
+    constexpr auto move_from(const Result &other) -> void = delete;
+
+    constexpr auto move_from(Result &&other) -> void
+    {
+        if (this == &other) {
+            return;
+        }
+        data_ = std::move(other.data_);
+    }
+
+    // ======================================================================
+    // Interoperability with std::expected
+    // ======================================================================
 
-namespace __detail
-{
+#if defined(__cpp_lib_expected)
+private:
+    template <typename Ex>
+    static constexpr auto from_expected(Ex &&ex) -> __detail::storage<T, E>
+    {
+        if (ex.has_value()) {
+            return __detail::storage<T, E>{__detail::OkTag{}, std::in_place,
+                                           *std::forward<Ex>(ex)};
+        }
+        return __detail::storage<T, E>{__detail::ErrTag{}, std::in_place,
+                                       std::forward<Ex>(ex).error()};
+    }
 
-struct OkTag
-{};
+public:
+    /**
+     * @brief Take over the content of a std::expected
+     *
+     * The payload is moved straight into the Result's storage.
+     */
+    template <typename U, typename G>
+        requires std::is_constructible_v<T, U &&> &&
+                 std::is_constructible_v<E, G &&>
+    constexpr explicit(!std::is_convertible_v<U &&, T> ||
+                       !std::is_convertible_v<G &&, E>)
+        Result(std::expected<U, G> &&ex)
+        : data_{from_expected(std::move(ex))}
+    {}
 
-struct ErrTag
-{};
+    /**
+     * @brief Move the content into a std::expected
+     */
+    [[nodiscard]] constexpr auto into_expected() && -> std::expected<T, E>
+        requires(!std::is_reference_v<T> && !std::is_reference_v<E>)
+    {
+        if (is_ok()) {
+            return std::expected<T, E>(std::in_place,
+                                       std::move(data_).value());
+        }
+        return std::expected<T, E>(std::unexpect, std::move(data_).error());
+    }
 
-template <typename T> struct value_type
-{
-    T value;
-    value_type(const T &d) : value{d} {}
-    value_type(T &&d) : value{std::move(d)} {}
-};
+    /**
+     * @brief Compare with a std::expected holding the same variant
+     *
+     * Keep the Result on the left: std::expected's own operator== claims
+     * the other order.
+     */
+    template <typename U, typename G>
+    [[nodiscard]] friend constexpr auto
+    operator==(const Result &lhs, const std::expected<U, G> &rhs) -> bool
+    {
+        if (lhs.is_ok() != rhs.has_value()) {
+            return false;
+        }
+        if (lhs.is_ok()) {
+            return lhs.data_.value() == *rhs;
+        }
+        return lhs.data_.error() == rhs.error();
+    }
+#endif
 
-template <typename E> struct error_type
-{
-    E error;
-    error_type(const E &e) : error{e} {}
-    error_type(E &&e) : error{std::move(e)} {}
-};
+    // ======================================================================
+    // Comparison
+    // ======================================================================
 
-template <typename> struct is_result_helper : std::false_type
-{};
+    [[nodiscard]] friend constexpr auto operator==(const Result &lhs,
+                                                   const Result &rhs) -> bool
+    {
+        if (lhs.is_ok() && rhs.is_ok()) {
+            return lhs.data_.value() ==
+                   rhs.data_.value();
+        }
+        if (lhs.is_err() && rhs.is_err()) {
+            return lhs.data_.error() ==
+                   rhs.data_.error();
+        }
+        return false;
+    }
 
-template <typename U, typename V>
-struct is_result_helper<Result<U, V>> : std::true_type
-{};
+    [[nodiscard]] friend constexpr auto operator!=(const Result &lhs,
+                                                   const Result &rhs) -> bool
+    {
+        return !(lhs == rhs);
+    }
 
-template <typename T>
-concept is_result_v = is_result_helper<std::remove_cvref_t<T>>::value;
+    template <typename U>
+    [[nodiscard]] friend constexpr auto operator==(const Result &lhs,
+                                                   const OkValue<U> &rhs)
+        -> bool
+    {
+        return lhs.is_ok() && lhs.data_.value() == rhs.value;
+    }
 
-} // namespace __detail
+    template <typename G>
+    [[nodiscard]] friend constexpr auto operator==(const Result &lhs,
+                                                   const ErrValue<G> &rhs)
+        -> bool
+    {
+        return lhs.is_err() && lhs.data_.error() == rhs.error;
+    }
+};
 
-template <typename T, typename E>
-class [[nodiscard("Result must be used")]] Result
+/**
+ * @brief Result of an operation that produces nothing but may fail
+ *
+ * Stores only the error and the discriminant, so it is as small as
+ * Result<Void, E>, and no larger than E when E has a niche. Ok() takes no
+ * argument, and the combinators that would pass the value take functions
+ * with no parameter.
+ */
+template <typename E> class [[nodiscard("Result must be used")]] Result<void, E>
 {
-    std::variant<__detail::value_type<T>, __detail::error_type<E>> data_;
+    __detail::storage<Void, E> data_;
+
+    template <typename... Args>
+    constexpr explicit Result(__detail::OkTag tag, Args &&...args)
+        : data_{tag, std::forward<Args>(args)...}
+    {}
 
-    Result(__detail::OkTag, const T &v) : data_{__detail::value_type<T>{v}} {}
-    Result(__detail::OkTag, T &&v)
-        : data_{__detail::value_type<T>{std::forward<T>(v)}}
+    template <typename... Args>
+    constexpr explicit Result(__detail::ErrTag tag, Args &&...args)
+        : data_{tag, std::forward<Args>(args)...}
     {}
-    Result(__detail::ErrTag, const E &e) : data_{__detail::error_type<E>{e}} {}
-    Result(__detail::ErrTag, E &&e)
-        : data_{__detail::error_type<E>{std::forward<E>(e)}}
+
+    constexpr explicit Result(__detail::storage<Void, E> &&data)
+        : data_{std::move(data)}
     {}
 
-    Result(const Result &other) = default;
-    auto operator=(const Result &other) -> Result & = default;
+    template <typename, typename> friend class Result;
+    friend struct __detail::try_access;
 
-    Result(Result &&other) = default;
-    auto operator=(Result &&other) -> Result & = default;
+public:
+    /**
+     * @brief Copy and move, each available, trivial and noexcept exactly
+     *        when it is for both payloads
+     */
+    constexpr Result(const Result &other) = default;
+    constexpr auto operator=(const Result &other) -> Result & = default;
+
+    constexpr Result(Result &&other) = default;
+    constexpr auto operator=(Result &&other) -> Result & = default;
+
+    /**
+     * @brief Receive an error propagated by RSTD_TRY, converting it to E
+     */
+    template <typename Ref>
+        requires std::is_constructible_v<E, Ref &&>
+    constexpr Result(__detail::propagated_error<Ref> propagated)
+        : data_{__detail::ErrTag{RSTD_ERR_SITE(propagated.site)},
+                std::forward<Ref>(propagated.error)}
+    {}
 
-    template <typename panic_type>
-    [[noreturn]] void unwrap_failed(const char *msg,
-                                    const panic_type &value) const
-        requires is_printable<panic_type>
-    {
-        std::ostringstream oss;
-        oss << msg << ": " << value;
-        throw std::runtime_error(oss.str());
-    }
+    /**
+     * @brief Build an Ok Result from Ok()
+     */
+    constexpr Result(OkValue<void>) : data_{__detail::OkTag{}, Void{}} {}
+
+    /**
+     * @brief Build an Err Result from Err(error), moving the payload into
+     *        place
+     */
+    template <typename G>
+        requires std::is_constructible_v<E, G &&>
+    constexpr explicit(!std::is_convertible_v<G &&, E>)
+        Result(ErrValue<G> &&err)
+        : data_{__detail::ErrTag{RSTD_ERR_SITE(err.site)}, std::in_place,
+                std::move(err.error)}
+    {}
 
-    template <typename panic_type>
-    [[noreturn]] [[deprecated(
-        "Use printable types or provide operator<< overload.")]]
-    void unwrap_failed(const char *msg,
-                       [[maybe_unused]] const panic_type &value) const
-        requires(!is_printable<panic_type>)
-    {
-        throw std::runtime_error(msg);
-    }
+    template <typename G>
+        requires std::is_constructible_v<E, const G &>
+    constexpr explicit(!std::is_convertible_v<const G &, E>)
+        Result(const ErrValue<G> &err)
+        : data_{__detail::ErrTag{RSTD_ERR_SITE(err.site)}, std::in_place,
+                err.error}
+    {}
 
-public:
-    // Friend declarations for factory functions
     template <typename U, typename V>
-    friend auto Ok(const U &v) -> Result<U, V>;
-    template <typename U, typename V> friend auto Ok(U &&v) -> Result<U, V>;
+        requires std::is_void_v<U>
+    friend constexpr auto Ok() -> Result<U, V>;
     template <typename U, typename V>
-    friend auto Err(const V &e) -> Result<U, V>;
-    template <typename U, typename V> friend auto Err(V &&e) -> Result<U, V>;
+    friend constexpr auto Err(const V &e RSTD_ERR_SITE_DECL) -> Result<U, V>;
+    template <typename U, typename V>
+    friend constexpr auto Err(V &&e RSTD_ERR_SITE_DECL) -> Result<U, V>;
 
     // ======================================================================
     // Object creations
     // ======================================================================
 
-    [[nodiscard("Result must be used")]] static auto Ok(const T &value)
-        -> Result
+    [[nodiscard("Result must be used")]] static constexpr auto Ok() -> Result
     {
-        return Result(__detail::OkTag{}, value);
+        return Result(__detail::OkTag{}, Void{});
     }
 
-    [[nodiscard("Result must be used")]] static auto Ok(T &&value) -> Result
+    [[nodiscard("Result must be used")]] static constexpr auto
+    Err(const E &error RSTD_ERR_SITE_PARAM) -> Result
     {
-        return Result(__detail::OkTag{}, std::move(value));
+        return Result(__detail::ErrTag{RSTD_ERR_SITE(site)}, error);
     }
 
-    [[nodiscard("Result must be used")]] static auto Err(const E &error)
-        -> Result
+    [[nodiscard("Result must be used")]] static constexpr auto
+    Err(std::remove_reference_t<E> &&error RSTD_ERR_SITE_PARAM) -> Result
+        requires(!std::is_reference_v<E>)
     {
-        return Result(__detail::ErrTag{}, error);
+        return Result(__detail::ErrTag{RSTD_ERR_SITE(site)}, std::move(error));
     }
 
-    [[nodiscard("Result must be used")]] static auto Err(E &&error) -> Result
+    [[nodiscard("Result must be used"), gnu::cold, gnu::noinline]] static auto
+    ErrCold(const E &error RSTD_ERR_SITE_PARAM) -> Result
     {
-        return Result(__detail::ErrTag{}, std::move(error));
+        return Result(__detail::ErrTag{RSTD_ERR_SITE(site)}, error);
     }
 
-    // ======================================================================
-    // Querying the contained values
-    // ======================================================================
+    [[nodiscard("Result must be used"), gnu::cold, gnu::noinline]] static auto
+    ErrCold(std::remove_reference_t<E> &&error RSTD_ERR_SITE_PARAM) -> Result
+        requires(!std::is_reference_v<E>)
+    {
+        return Result(__detail::ErrTag{RSTD_ERR_SITE(site)}, std::move(error));
+    }
 
-    [[nodiscard]] auto is_ok() const -> bool
+    /**
+     * @brief Construct the Err value in place from constructor arguments
+     */
+    template <typename... Args>
+        requires std::is_constructible_v<E, Args...>
+    [[nodiscard("Result must be used")]] static constexpr auto
+    Err(std::in_place_t, Args &&...args) -> Result
     {
-        return std::holds_alternative<__detail::value_type<T>>(data_);
+        return Result(__detail::ErrTag{}, std::in_place,
+                      std::forward<Args>(args)...);
     }
 
-    template <typename Pred>
-        requires fn_return_boolean<Pred, T>
-    [[nodiscard]] auto is_ok_and(Pred &&pred) const & -> bool
+    // ======================================================================
+    // Replacing the contained values
+    // ======================================================================
+
+    /**
+     * @brief Destroy the current error, if any, and become Ok
+     */
+    constexpr auto emplace_ok() noexcept -> void { data_.emplace_value(); }
+
+    /**
+     * @brief Destroy the current content and construct an Err value in place
+     *
+     * If the constructor throws, the Result keeps its previous content.
+     *
+     * @return reference to the new error
+     */
+    template <typename... Args>
+        requires std::is_constructible_v<E, Args...>
+    constexpr auto emplace_err(Args &&...args) -> E &
     {
-        return is_ok() && std::forward<Pred>(pred)(
-                              std::get<__detail::value_type<T>>(data_).value);
+        return data_.emplace_error(std::forward<Args>(args)...);
     }
 
-    template <typename Pred>
-        requires fn_return_boolean<Pred, T>
-    [[nodiscard]] auto is_ok_and(Pred &&pred) && -> bool
+    // ======================================================================
+    // Querying the contained values
+    // ======================================================================
+
+    [[nodiscard]] constexpr auto is_ok() const -> bool
     {
-        return is_ok() && std::forward<Pred>(pred)(std::move(
-                              std::get<__detail::value_type<T>>(data_).value));
+        return data_.is_ok();
     }
 
-    [[nodiscard]] auto is_err() const -> bool
+    [[nodiscard]] constexpr auto is_err() const -> bool
     {
-        return std::holds_alternative<__detail::error_type<E>>(data_);
+        return !data_.is_ok();
     }
 
     template <typename Pred>
         requires fn_return_boolean<Pred, E>
-    [[nodiscard]] auto is_err_and(Pred &&pred) const & -> bool
+    [[nodiscard]] constexpr auto is_err_and(Pred &&pred) const & -> bool
     {
-        return is_err() && std::forward<Pred>(pred)(
-                               std::get<__detail::error_type<E>>(data_).error);
+        return is_err() && std::forward<Pred>(pred)(data_.error());
     }
 
     template <typename Pred>
         requires fn_return_boolean<Pred, E>
-    [[nodiscard]] auto is_err_and(Pred &&pred) && -> bool
+    [[nodiscard]] constexpr auto is_err_and(Pred &&pred) && -> bool
+    {
+        return is_err() && std::forward<Pred>(pred)(std::move(data_).error());
+    }
+
+#if RSTD_ERROR_LOCATIONS
+    /**
+     * @brief Call site of the Err factory that created the error
+     *
+     * Combinators, RSTD_TRY and co_await pass it along with the error. An
+     * Ok, or an error built in place, has a default-constructed location.
+     * Only available when compiled with RSTD_ERROR_LOCATIONS.
+     */
+    [[nodiscard]] constexpr auto error_location() const noexcept
+        -> std::source_location
     {
-        return is_err() && std::forward<Pred>(pred)(std::move(
-                               std::get<__detail::error_type<E>>(data_).error));
+        return data_.site();
     }
+#endif
 
     // ======================================================================
-    // Adapter for each variant
+    // Borrowing the contained values
     // ======================================================================
 
-    [[nodiscard]] auto ok() const & -> std::optional<T>
+    /**
+     * @brief Borrow the error without copying it
+     */
+    [[nodiscard]] constexpr auto as_ref() const & -> Result<void, const E &>
+    {
+        if (is_ok()) {
+            return Result<void, const E &>::Ok();
+        }
+        return Result<void, const E &>(data_.err_tag(), data_.error());
+    }
+
+    /**
+     * @brief Mutably borrow the error
+     */
+    [[nodiscard]] constexpr auto as_mut() & -> Result<void, E &>
+    {
+        if (is_ok()) {
+            return Result<void, E &>::Ok();
+        }
+        return Result<void, E &>(data_.err_tag(), data_.error());
+    }
+
+    auto as_ref() const && -> Result<void, const E &> = delete;
+    auto as_mut() && -> Result<void, E &> = delete;
+
+    /**
+     * @brief Reference to the Err value; panics on Ok
+     */
+    [[nodiscard]] constexpr auto error() & -> E &
+    {
+        if (is_ok()) {
+            __detail::unwrap_failed(
+                "called `Result::error()` on an `Ok` value", Void{});
+        }
+        return data_.error();
+    }
+
+    [[nodiscard]] constexpr auto error() const & -> const E &
     {
         if (is_ok()) {
-            return std::optional<T>(
-                std::get<__detail::value_type<T>>(data_).value);
+            __detail::unwrap_failed(
+                "called `Result::error()` on an `Ok` value", Void{});
         }
-        return std::nullopt;
+        return data_.error();
     }
 
-    [[nodiscard]] auto ok() && -> std::optional<T>
+    [[nodiscard]] constexpr auto error() && -> E &&
     {
         if (is_ok()) {
-            return std::optional<T>(
-                std::move(std::get<__detail::value_type<T>>(data_).value));
+            __detail::unwrap_failed(
+                "called `Result::error()` on an `Ok` value", Void{});
         }
-        return std::nullopt;
+        return std::move(data_).error();
+    }
+
+    /**
+     * @brief The Err value, without checking the discriminant
+     *
+     * For callers that have already tested is_err(). Calling this on an Ok
+     * is undefined behavior.
+     */
+    [[nodiscard]] constexpr auto unwrap_err_unchecked() & noexcept -> E &
+    {
+        return data_.error();
+    }
+
+    [[nodiscard]] constexpr auto unwrap_err_unchecked() const & noexcept
+        -> const E &
+    {
+        return data_.error();
+    }
+
+    [[nodiscard]] constexpr auto unwrap_err_unchecked() && noexcept(
+        std::is_nothrow_move_constructible_v<E>) -> E
+    {
+        return std::move(data_).error();
     }
 
-    [[nodiscard]] auto err() const & -> std::optional<E>
+    // ======================================================================
+    // Adapter for each variant
+    // ======================================================================
+
+    /**
+     * @brief The error as an Option; an rvalue Result moves it out
+     */
+    [[nodiscard]] constexpr auto err() const & -> Option<E>
     {
         if (is_err()) {
-            return std::optional<E>(
-                std::get<__detail::error_type<E>>(data_).error);
+            return Option<E>(std::in_place, data_.error());
         }
-        return std::nullopt;
+        return Option<E>();
     }
 
-    [[nodiscard]] auto err() && -> std::optional<E>
+    [[nodiscard]] constexpr auto err() && -> Option<E>
     {
         if (is_err()) {
-            return std::optional<E>(
-                std::move(std::get<__detail::error_type<E>>(data_).error));
+            return Option<E>(std::in_place, std::move(data_).error());
         }
-        return std::nullopt;
+        return Option<E>();
     }
 
     // ======================================================================
@@ -215,123 +2113,101 @@ public:
 
     template <typename FnOk>
     constexpr auto
-    map(FnOk &&fn) const & -> Result<std::invoke_result_t<FnOk, T>, E>
+    map(FnOk &&fn) const & -> Result<std::invoke_result_t<FnOk>, E>
     {
-        using U = std::invoke_result_t<FnOk, T>;
+        using U = std::invoke_result_t<FnOk>;
         if (is_ok()) {
-            return Result<U, E>::Ok(std::forward<FnOk>(fn)(
-                std::get<__detail::value_type<T>>(data_).value));
+            return __detail::ok_from<Result<U, E>>(std::forward<FnOk>(fn));
         }
-        return Result<U, E>::Err(
-            std::get<__detail::error_type<E>>(data_).error);
+        return Result<U, E>(data_.err_tag(), data_.error());
     }
 
     template <typename FnOk>
-    constexpr auto map(FnOk &&fn) && -> Result<std::invoke_result_t<FnOk, T>, E>
+    constexpr auto map(FnOk &&fn) && -> Result<std::invoke_result_t<FnOk>, E>
     {
-        using U = std::invoke_result_t<FnOk, T>;
+        using U = std::invoke_result_t<FnOk>;
         if (is_ok()) {
-            return Result<U, E>::Ok(std::forward<FnOk>(fn)(
-                std::move(std::get<__detail::value_type<T>>(data_).value)));
+            return __detail::ok_from<Result<U, E>>(std::forward<FnOk>(fn));
         }
-        return Result<U, E>::Err(
-            std::move(std::get<__detail::error_type<E>>(data_).error));
+        return Result<U, E>(data_.err_tag(), std::move(data_).error());
     }
 
     template <typename U, typename FnOk>
-        requires std::is_same_v<U, std::invoke_result_t<FnOk, T>>
-    constexpr auto map_or(const U &default_val, FnOk &&fn) const & -> U
-    {
-        if (is_ok()) {
-            return std::forward<FnOk>(fn)(
-                std::get<__detail::value_type<T>>(data_).value);
-        }
-        return default_val;
-    }
-
-    template <typename U, typename FnMap>
-        requires std::is_same_v<U, std::invoke_result_t<FnMap, T>>
-    constexpr auto map_or(const U &default_val, FnMap &&fn) && -> U
+        requires std::is_same_v<U, std::invoke_result_t<FnOk>>
+    constexpr auto map_or(const U &default_val, FnOk &&fn) const -> U
     {
         if (is_ok()) {
-            return std::forward<FnMap>(fn)(std::forward<T>(
-                std::move(std::get<__detail::value_type<T>>(data_).value)));
+            return std::forward<FnOk>(fn)();
         }
         return default_val;
     }
 
     template <typename FnErr, typename FnOk>
         requires std::is_same_v<std::invoke_result_t<FnErr, E>,
-                                std::invoke_result_t<FnOk, T>>
+                                std::invoke_result_t<FnOk>>
     constexpr auto
     map_or_else(FnErr &&fn_err,
-                FnOk &&fn_ok) const & -> std::invoke_result_t<FnOk, T>
+                FnOk &&fn_ok) const & -> std::invoke_result_t<FnOk>
     {
         if (is_ok()) {
-            return std::forward<FnOk>(fn_ok)(
-                std::get<__detail::value_type<T>>(data_).value);
+            return std::forward<FnOk>(fn_ok)();
         }
-        return std::forward<FnErr>(fn_err)(
-            std::get<__detail::error_type<E>>(data_).error);
+        return std::forward<FnErr>(fn_err)(data_.error());
     }
 
     template <typename FnErr, typename FnOk>
         requires std::is_same_v<std::invoke_result_t<FnErr, E>,
-                                std::invoke_result_t<FnOk, T>>
+                                std::invoke_result_t<FnOk>>
     constexpr auto map_or_else(FnErr &&fn_err,
-                               FnOk &&fn_ok) && -> std::invoke_result_t<FnOk, T>
+                               FnOk &&fn_ok) && -> std::invoke_result_t<FnOk>
     {
         if (is_ok()) {
-            return std::forward<FnOk>(fn_ok)(
-                std::move(std::get<__detail::value_type<T>>(data_).value));
+            return std::forward<FnOk>(fn_ok)();
         }
-        return std::forward<FnErr>(fn_err)(
-            std::move(std::get<__detail::error_type<E>>(data_).error));
+        return std::forward<FnErr>(fn_err)(std::move(data_).error());
     }
 
     template <typename FnErr>
     constexpr auto
-    map_err(FnErr &&fn) const & -> Result<T, std::invoke_result_t<FnErr, E>>
+    map_err(FnErr &&fn) const & -> Result<void, std::invoke_result_t<FnErr, E>>
     {
         using V = std::invoke_result_t<FnErr, E>;
         if (is_err()) {
-            return Result<T, V>::Err(std::forward<FnErr>(fn)(
-                std::get<__detail::error_type<E>>(data_).error));
+            return Result<void, V>(data_.err_tag(),
+                                   std::forward<FnErr>(fn)(data_.error()));
         }
-        return Result<T, V>::Ok(std::get<__detail::value_type<T>>(data_).value);
+        return Result<void, V>::Ok();
     }
 
     template <typename FnErr>
     constexpr auto
-    map_err(FnErr &&fn) && -> Result<T, std::invoke_result_t<FnErr, E>>
+    map_err(FnErr &&fn) && -> Result<void, std::invoke_result_t<FnErr, E>>
     {
         using V = std::invoke_result_t<FnErr, E>;
         if (is_err()) {
-            return Result<T, V>::Err(std::forward<FnErr>(fn)(
-                std::move(std::get<__detail::error_type<E>>(data_).error)));
+            return Result<void, V>(
+                data_.err_tag(),
+                std::forward<FnErr>(fn)(std::move(data_).error()));
         }
-        return Result<T, V>::Ok(
-            std::move(std::get<__detail::value_type<T>>(data_).value));
+        return Result<void, V>::Ok();
     }
 
     template <typename Fn>
-        requires fn_return_void<Fn, T>
+        requires fn_return_void<Fn>
     constexpr auto inspect(Fn &&fn) const & -> const Result &
     {
         if (is_ok()) {
-            std::forward<Fn>(fn)(
-                std::get<__detail::value_type<T>>(data_).value);
+            std::forward<Fn>(fn)();
         }
         return *this;
     }
 
     template <typename Fn>
-        requires fn_return_void<Fn, T>
+        requires fn_return_void<Fn>
     constexpr auto inspect(Fn &&fn) && -> Result &&
     {
         if (is_ok()) {
-            std::forward<Fn>(fn)(
-                std::move(std::get<__detail::value_type<T>>(data_).value));
+            std::forward<Fn>(fn)();
         }
         return std::move(*this);
     }
@@ -341,8 +2217,7 @@ public:
     constexpr auto inspect_err(Fn &&fn) const & -> const Result &
     {
         if (is_err()) {
-            std::forward<Fn>(fn)(
-                std::get<__detail::error_type<E>>(data_).error);
+            std::forward<Fn>(fn)(data_.error());
         }
         return *this;
     }
@@ -352,104 +2227,99 @@ public:
     constexpr auto inspect_err(Fn &&fn) && -> Result &&
     {
         if (is_err()) {
-            std::forward<Fn>(fn)(
-                std::move(std::get<__detail::error_type<E>>(data_).error));
+            std::forward<Fn>(fn)(std::move(data_).error());
         }
         return std::move(*this);
     }
 
     // ======================================================================
-    // Extract a value
+    // Attaching context to the error
     // ======================================================================
 
-    auto expect(const char *msg) const & -> T
-    {
-        if (is_ok()) {
-            return std::get<__detail::value_type<T>>(data_).value;
-        }
-        const E &e = std::get<__detail::error_type<E>>(data_).error;
-        unwrap_failed(msg, e);
-    }
-
-    auto expect(const char *msg) && -> T
+    /**
+     * @brief Add @p msg, and at most one small @p arg, as context to the
+     *        error
+     */
+    template <typename... Args>
+        requires(sizeof...(Args) <= 1 && (context_arg<Args> && ...))
+    auto context(const char *msg,
+                 Args... arg) const & -> Result<void, context_t<E>>
     {
+        using R = Result<void, context_t<E>>;
         if (is_ok()) {
-            return std::move(std::get<__detail::value_type<T>>(data_).value);
+            return R::Ok();
         }
-        const E &e = std::get<__detail::error_type<E>>(data_).error;
-        unwrap_failed(msg, e);
+        auto res = R(data_.err_tag(), std::in_place, data_.error());
+        res.data_.error().push(ContextFrame(msg, arg...));
+        return res;
     }
 
-    auto unwrap() const & -> T
+    template <typename... Args>
+        requires(sizeof...(Args) <= 1 && (context_arg<Args> && ...))
+    auto context(const char *msg, Args... arg) && -> Result<void, context_t<E>>
     {
+        using R = Result<void, context_t<E>>;
         if (is_ok()) {
-            return std::get<__detail::value_type<T>>(data_).value;
+            return R::Ok();
         }
-        const E &e = std::get<__detail::error_type<E>>(data_).error;
-        unwrap_failed("called `Result::unwrap()` on an `Err` value", e);
+        auto res = R(data_.err_tag(), std::in_place, std::move(data_).error());
+        res.data_.error().push(ContextFrame(msg, arg...));
+        return res;
     }
 
-    auto unwrap() && -> T
-    {
-        if (is_ok()) {
-            return std::move(std::get<__detail::value_type<T>>(data_).value);
-        }
-        const E &e = std::get<__detail::error_type<E>>(data_).error;
-        unwrap_failed("called `Result::unwrap()` on an `Err` value", e);
-    }
+    // ======================================================================
+    // Extract a value
+    // ======================================================================
 
-    auto unwrap_or_default() const & -> T
-        requires is_default_constructible<T>
+    constexpr auto expect(const char *msg) const -> void
     {
-        if (is_ok()) {
-            return std::get<__detail::value_type<T>>(data_).value;
+        if (is_err()) {
+            const E &e = data_.error();
+            __detail::unwrap_failed(msg, e);
         }
-        return T{};
     }
 
-    auto unwrap_or_default() && -> T
-        requires is_default_constructible<T>
+    constexpr auto unwrap() const -> void
     {
-        if (is_ok()) {
-            return std::move(std::get<__detail::value_type<T>>(data_).value);
+        if (is_err()) {
+            const E &e = data_.error();
+            __detail::unwrap_failed(
+                "called `Result::unwrap()` on an `Err` value", e);
         }
-        return T{};
     }
 
-    auto expect_err(const char *msg) const & -> E
+    constexpr auto expect_err(const char *msg) const & -> E
     {
         if (is_err()) {
-            return std::get<__detail::error_type<E>>(data_).error;
+            return data_.error();
         }
-        const T &v = std::get<__detail::value_type<T>>(data_).value;
-        unwrap_failed(msg, v);
+        __detail::unwrap_failed(msg, Void{});
     }
 
-    auto expect_err(const char *msg) && -> E
+    constexpr auto expect_err(const char *msg) && -> E
     {
         if (is_err()) {
-            return std::move(std::get<__detail::error_type<E>>(data_).error);
+            return std::move(data_).error();
         }
-        const T &v = std::get<__detail::value_type<T>>(data_).value;
-        unwrap_failed(msg, v);
+        __detail::unwrap_failed(msg, Void{});
     }
 
-    auto unwrap_err() const & -> E
+    constexpr auto unwrap_err() const & -> E
     {
         if (is_err()) {
-            return std::get<__detail::error_type<E>>(data_).error;
+            return data_.error();
         }
-        const T &v = std::get<__detail::value_type<T>>(data_).value;
-        unwrap_failed("called `Result::unwrap_err()` on an `Ok` value", v);
+        __detail::unwrap_failed(
+            "called `Result::unwrap_err()` on an `Ok` value", Void{});
     }
 
-    auto unwrap_err() && -> E
+    constexpr auto unwrap_err() && -> E
     {
         if (is_err()) {
-            return std::move(std::get<__detail::error_type<E>>(data_).error);
+            return std::move(data_).error();
         }
-        const T &v = std::get<__detail::value_type<T>>(data_).value;
-        unwrap_failed("called `Result::unwrap_err()` on an `Ok` value", v);
+        __detail::unwrap_failed(
+            "called `Result::unwrap_err()` on an `Ok` value", Void{});
     }
 
     template <typename U>
@@ -458,8 +2328,7 @@ public:
         if (is_ok()) {
             return res;
         }
-        return Result<U, E>::Err(
-            std::get<__detail::error_type<E>>(data_).error);
+        return Result<U, E>(data_.err_tag(), data_.error());
     }
 
     template <typename U>
@@ -468,8 +2337,7 @@ public:
         if (is_ok()) {
             return std::forward<Result<U, E>>(res);
         }
-        return Result<U, E>::Err(
-            std::get<__detail::error_type<E>>(data_).error);
+        return Result<U, E>(data_.err_tag(), data_.error());
     }
 
     template <typename U>
@@ -478,60 +2346,45 @@ public:
         if (is_ok()) {
             return std::forward<Result<U, E>>(res);
         }
-        return Result<U, E>::Err(
-            std::move(std::get<__detail::error_type<E>>(data_).error));
+        return Result<U, E>(data_.err_tag(), std::move(data_).error());
     }
 
     template <typename Fn>
-        requires __detail::is_result_v<std::invoke_result_t<Fn, T>>
+        requires __detail::is_result_v<std::invoke_result_t<Fn>>
     constexpr auto and_then(Fn &&fn) const &
     {
-        using Ret = std::invoke_result_t<Fn, T>;
+        using Ret = std::invoke_result_t<Fn>;
         if (is_ok()) {
-            return std::forward<Fn>(fn)(
-                std::get<__detail::value_type<T>>(data_).value);
+            return std::forward<Fn>(fn)();
         }
-        return Ret::Err(std::get<__detail::error_type<E>>(data_).error);
+        return Ret(data_.err_tag(), data_.error());
     }
 
     template <typename Fn>
-        requires __detail::is_result_v<std::invoke_result_t<Fn, T>>
+        requires __detail::is_result_v<std::invoke_result_t<Fn>>
     constexpr auto and_then(Fn &&fn) &&
     {
-        using Ret = std::invoke_result_t<Fn, T>;
+        using Ret = std::invoke_result_t<Fn>;
         if (is_ok()) {
-            return std::forward<Fn>(fn)(
-                std::move(std::get<__detail::value_type<T>>(data_).value));
+            return std::forward<Fn>(fn)();
         }
-        return Ret::Err(
-            std::move(std::get<__detail::error_type<E>>(data_).error));
+        return Ret(data_.err_tag(), std::move(data_).error());
     }
 
-    constexpr auto or_(const Result<T, E> &res) const & -> Result<T, E>
+    constexpr auto or_(const Result &res) const & -> Result
     {
         if (is_ok()) {
-            return Result<T, E>::Ok(
-                std::get<__detail::value_type<T>>(data_).value);
+            return Ok();
         }
         return res;
     }
 
-    constexpr auto or_(Result<T, E> &&res) const & -> Result<T, E>
-    {
-        if (is_ok()) {
-            return Result<T, E>::Ok(
-                std::get<__detail::value_type<T>>(data_).value);
-        }
-        return std::forward<Result<T, E>>(res);
-    }
-
-    constexpr auto or_(Result<T, E> &&res) && -> Result<T, E>
+    constexpr auto or_(Result &&res) const -> Result
     {
         if (is_ok()) {
-            return Result<T, E>::Ok(
-                std::move(std::get<__detail::value_type<T>>(data_).value));
+            return Ok();
         }
-        return std::forward<Result<T, E>>(res);
+        return std::move(res);
     }
 
     template <typename Fn>
@@ -540,11 +2393,9 @@ public:
     {
         using Ret = std::invoke_result_t<Fn, E>;
         if (is_ok()) {
-            return Ret::Ok(std::get<__detail::value_type<T>>(data_).value);
+            return Ret::Ok();
         }
-
-        return std::forward<Fn>(fn)(
-            std::get<__detail::error_type<E>>(data_).error);
+        return std::forward<Fn>(fn)(data_.error());
     }
 
     template <typename Fn>
@@ -553,122 +2404,126 @@ public:
     {
         using Ret = std::invoke_result_t<Fn, E>;
         if (is_ok()) {
-            return Ret::Ok(
-                std::move(std::get<__detail::value_type<T>>(data_).value));
+            return Ret::Ok();
         }
-
-        return std::forward<Fn>(fn)(
-            std::move(std::get<__detail::error_type<E>>(data_).error));
+        return std::forward<Fn>(fn)(std::move(data_).error());
     }
 
     // ======================================================================
     // Impl Clone for Result
     // ======================================================================
 
-    auto clone() const & -> Result
-        requires(is_cloneable<T> && is_cloneable<E>)
+    constexpr auto clone() const & -> Result
+        requires is_cloneable<E>
     {
         return Result(*this);
     }
 
-    [[deprecated("Cloning an rvalue Result is unnecessary. Use std::move() or "
-                 "just assign the rvalue directly.")]] auto
-    clone() && -> Result
-        requires(is_cloneable<T> && is_cloneable<E>)
-    {
-        return std::move(*this);
-    }
-
-    auto clone_from(const Result &other) -> void
-        requires(is_cloneable<T> && is_cloneable<E>)
+    constexpr auto clone_from(const Result &other) -> void
+        requires is_cloneable<E>
     {
         if (this == &other) {
             return;
         }
-
-        if (other.is_ok()) {
-            const T &val = std::get<__detail::value_type<T>>(other.data_).value;
-            if (is_ok()) {
-                std::get<__detail::value_type<T>>(data_).value = val;
-            } else {
-                data_.template emplace<__detail::value_type<T>>(val);
-            }
-        } else {
-            const E &err = std::get<__detail::error_type<E>>(other.data_).error;
-            if (is_err()) {
-                std::get<__detail::error_type<E>>(data_).error = err;
-            } else {
-                data_.template emplace<__detail::error_type<E>>(err);
-            }
-        }
+        data_ = other.data_;
     }
 
-    [[deprecated(
-        "clone_from() with rvalue is inefficient. Use move_from() for moving "
-        "from rvalues, or clone_from(const Result&) for copying.")]]
-    auto clone_from(Result &&other) -> void
-        requires(is_cloneable<T> && is_cloneable<E>)
+    constexpr auto move_from(const Result &other) -> void = delete;
+
+    constexpr auto move_from(Result &&other) -> void
     {
         if (this == &other) {
             return;
         }
+        data_ = std::move(other.data_);
+    }
 
-        if (other.is_ok()) {
-            auto &&val =
-                std::move(std::get<__detail::value_type<T>>(other.data_).value);
-            if (is_ok()) {
-                std::get<__detail::value_type<T>>(data_).value =
-                    std::forward<T>(val);
-            } else {
-                data_.template emplace<__detail::value_type<T>>(
-                    std::forward<T>(val));
-            }
-        } else {
-            auto &&err =
-                std::move(std::get<__detail::error_type<E>>(other.data_).error);
-            if (is_err()) {
-                std::get<__detail::error_type<E>>(data_).error =
-                    std::forward<E>(err);
-            } else {
-                data_.template emplace<__detail::error_type<E>>(
-                    std::forward<E>(err));
-            }
+    // ======================================================================
+    // Interoperability with std::expected
+    // ======================================================================
+
+#if defined(__cpp_lib_expected)
+private:
+    template <typename Ex>
+    static constexpr auto from_expected(Ex &&ex) -> __detail::storage<Void, E>
+    {
+        if (ex.has_value()) {
+            return __detail::storage<Void, E>{__detail::OkTag{}, Void{}};
         }
+        return __detail::storage<Void, E>{__detail::ErrTag{}, std::in_place,
+                                          std::forward<Ex>(ex).error()};
     }
 
-    auto move_from(const Result &other) -> void = delete;
+public:
+    /**
+     * @brief Take over the content of a std::expected<void, G>
+     */
+    template <typename G>
+        requires std::is_constructible_v<E, G &&>
+    constexpr explicit(!std::is_convertible_v<G &&, E>)
+        Result(std::expected<void, G> &&ex)
+        : data_{from_expected(std::move(ex))}
+    {}
 
-    auto move_from(Result &&other) -> void
+    /**
+     * @brief Move the content into a std::expected<void, E>
+     */
+    [[nodiscard]] constexpr auto into_expected() && -> std::expected<void, E>
+        requires(!std::is_reference_v<E>)
     {
-        if (this == &other) {
-            return;
+        if (is_ok()) {
+            return std::expected<void, E>();
         }
-        data_ = std::move(other.data_);
+        return std::expected<void, E>(std::unexpect,
+                                      std::move(data_).error());
+    }
+
+    /**
+     * @brief Compare with a std::expected holding the same variant
+     */
+    template <typename G>
+    [[nodiscard]] friend constexpr auto
+    operator==(const Result &lhs, const std::expected<void, G> &rhs) -> bool
+    {
+        if (lhs.is_ok() != rhs.has_value()) {
+            return false;
+        }
+        return lhs.is_ok() || lhs.data_.error() == rhs.error();
     }
+#endif
 
     // ======================================================================
     // Comparison
     // ======================================================================
 
-    [[nodiscard]] friend auto operator==(const Result &lhs, const Result &rhs)
-        -> bool
+    [[nodiscard]] friend constexpr auto operator==(const Result &lhs,
+                                                   const Result &rhs) -> bool
     {
-        if (lhs.is_ok() && rhs.is_ok()) {
-            return std::get<__detail::value_type<T>>(lhs.data_).value ==
-                   std::get<__detail::value_type<T>>(rhs.data_).value;
-        }
-        if (lhs.is_err() && rhs.is_err()) {
-            return std::get<__detail::error_type<E>>(lhs.data_).error ==
-                   std::get<__detail::error_type<E>>(rhs.data_).error;
+        if (lhs.is_ok() || rhs.is_ok()) {
+            return lhs.is_ok() && rhs.is_ok();
         }
-        return false;
+        return lhs.data_.error() == rhs.data_.error();
     }
 
-    [[nodiscard]] friend auto operator!=(const Result &lhs, const Result &rhs)
-        -> bool
+    [[nodiscard]] friend constexpr auto operator!=(const Result &lhs,
+                                                   const Result &rhs) -> bool
     {
         return !(lhs == rhs);
     }
+
+    [[nodiscard]] friend constexpr auto operator==(const Result &lhs,
+                                                   OkValue<void>) -> bool
+    {
+        return lhs.is_ok();
+    }
+
+    template <typename G>
+    [[nodiscard]] friend constexpr auto operator==(const Result &lhs,
+                                                   const ErrValue<G> &rhs)
+        -> bool
+    {
+        return lhs.is_err() && lhs.data_.error() == rhs.error;
+    }
 };
 
 // ======================================================================
@@ -676,27 +2531,60 @@ public:
 // ======================================================================
 
 template <typename U, typename V>
-[[nodiscard("Result must be used")]] auto Ok(const U &v) -> Result<U, V>
+[[nodiscard("Result must be used")]] constexpr auto Ok(const U &v)
+    -> Result<U, V>
 {
     return Result<U, V>(__detail::OkTag{}, v);
 }
 
 template <typename U, typename V>
-[[nodiscard("Result must be used")]] auto Ok(U &&v) -> Result<U, V>
+[[nodiscard("Result must be used")]] constexpr auto Ok(U &&v) -> Result<U, V>
 {
     return Result<U, V>(__detail::OkTag{}, std::move(v));
 }
 
 template <typename U, typename V>
-[[nodiscard("Result must be used")]] auto Err(const V &e) -> Result<U, V>
+    requires std::is_void_v<U>
+[[nodiscard("Result must be used")]] constexpr auto Ok() -> Result<U, V>
+{
+    return Result<U, V>(__detail::OkTag{}, Void{});
+}
+
+template <typename U, typename V>
+[[nodiscard("Result must be used")]] constexpr auto
+Err(const V &e RSTD_ERR_SITE_PARAM) -> Result<U, V>
 {
-    return Result<U, V>(__detail::ErrTag{}, e);
+    return Result<U, V>(__detail::ErrTag{RSTD_ERR_SITE(site)}, e);
 }
 
 template <typename U, typename V>
-[[nodiscard("Result must be used")]] auto Err(V &&e) -> Result<U, V>
+[[nodiscard("Result must be used")]] constexpr auto
+Err(V &&e RSTD_ERR_SITE_PARAM) -> Result<U, V>
 {
-    return Result<U, V>(__detail::ErrTag{}, std::move(e));
+    return Result<U, V>(__detail::ErrTag{RSTD_ERR_SITE(site)}, std::move(e));
 }
 
 } // namespace rstd::result
+
+namespace rstd
+{
+
+using result::Err;
+using result::ErrValue;
+using result::Ok;
+using result::OkValue;
+
+/**
+ * @brief A Result relocates with memcpy when both of its payloads do
+ */
+template <typename T, typename E>
+struct is_trivially_relocatable<result::Result<T, E>>
+    : std::bool_constant<result::__detail::trivially_relocatable_pair<
+          result::__detail::value_or_unit_t<T>, E>>
+{};
+
+} // namespace rstd
+
+// Option's conversions need the complete Result, and Result's ok() and
+// err() the complete Option
+#include "option.hpp"
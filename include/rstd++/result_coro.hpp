@@ -0,0 +1,291 @@
+#pragma once
+
+#include <coroutine>
+#include <cstddef>
+#include <new>
+#include <optional>
+#include <type_traits>
+#include <utility>
+
+#include "panic.hpp"
+#include "result.hpp"
+
+/**
+ * @file result_coro.hpp
+ * @brief Write functions returning Result<T, E> as coroutines
+ *
+ * Including this header lets a function returning Result<T, E> use
+ * `co_await` on another Result: an Ok yields its value, an Err ends the
+ * function and is returned, converted to E. `co_return value` returns
+ * Ok(value); `co_return` of a Result<T, E> returns it unchanged.
+ *
+ * @code
+ * auto sum(const std::string &a, const std::string &b) -> Result<int, Error>
+ * {
+ *     int x = co_await parse(a);
+ *     int y = co_await parse(b);
+ *     co_return x + y;
+ * }
+ * @endcode
+ *
+ * These coroutines run synchronously to completion before the call
+ * returns, so their frames are strictly nested. Frames are therefore
+ * carved from a per-thread stack arena instead of the heap; only frames
+ * that do not fit fall back to operator new.
+ *
+ * The body runs before the Result is built from the return object, which
+ * relies on the compiler converting that object lazily, as GCC, MSVC and
+ * Clang 17 and later do. A compiler that converts it eagerly panics on the
+ * first call instead of reading an unset outcome.
+ */
+
+#ifndef RSTD_RESULT_CORO_ARENA_SIZE
+#define RSTD_RESULT_CORO_ARENA_SIZE (64 * 1024)
+#endif
+
+namespace rstd::result::__detail
+{
+
+/**
+ * @brief Per-thread LIFO allocator for Result coroutine frames
+ *
+ * The buffer is allocated on first use and reused for the lifetime of the
+ * thread, so steady-state calls do not touch the heap. Releasing any frame
+ * but the most recent one panics, in release builds too.
+ */
+class frame_arena
+{
+    static constexpr std::size_t capacity = RSTD_RESULT_CORO_ARENA_SIZE;
+    static constexpr std::size_t align = __STDCPP_DEFAULT_NEW_ALIGNMENT__;
+
+    std::byte *buffer_ = nullptr;
+    std::size_t top_ = 0;
+
+    static constexpr auto round_up(std::size_t n) noexcept -> std::size_t
+    {
+        return (n + align - 1) / align * align;
+    }
+
+    auto owns(const void *p) const noexcept -> bool
+    {
+        const auto *b = static_cast<const std::byte *>(p);
+        return buffer_ != nullptr && b >= buffer_ && b < buffer_ + capacity;
+    }
+
+public:
+    frame_arena() = default;
+    frame_arena(const frame_arena &) = delete;
+    auto operator=(const frame_arena &) -> frame_arena & = delete;
+
+    ~frame_arena() { ::operator delete(buffer_); }
+
+    auto allocate(std::size_t n) -> void *
+    {
+        n = round_up(n);
+        if (buffer_ == nullptr) {
+            buffer_ = static_cast<std::byte *>(::operator new(capacity));
+        }
+        if (capacity - top_ < n) {
+            return ::operator new(n);
+        }
+        void *p = buffer_ + top_;
+        top_ += n;
+        return p;
+    }
+
+    auto deallocate(void *p, std::size_t n) noexcept -> void
+    {
+        if (!owns(p)) {
+            ::operator delete(p);
+            return;
+        }
+        n = round_up(n);
+        if (n > top_ || p != buffer_ + (top_ - n)) [[unlikely]] {
+            panic::__detail::begin_panic(
+                "Result coroutine frames released out of order", nullptr,
+                nullptr);
+        }
+        top_ -= n;
+    }
+
+    [[nodiscard]] auto in_use() const noexcept -> std::size_t { return top_; }
+
+    static auto local() noexcept -> frame_arena &
+    {
+        thread_local frame_arena arena;
+        return arena;
+    }
+};
+
+template <typename T, typename E> class result_promise;
+template <typename T, typename E> class coro_return;
+
+/**
+ * @brief Suspends a Result coroutine on co_await of an Err
+ */
+template <typename R, typename T, typename E> class result_awaiter
+{
+    R &&result_;
+    result_promise<T, E> *promise_;
+
+public:
+    result_awaiter(R &&result, result_promise<T, E> *promise) noexcept
+        : result_{std::forward<R>(result)}, promise_{promise}
+    {}
+
+    [[nodiscard]] auto await_ready() const noexcept -> bool
+    {
+        return result_.is_ok();
+    }
+
+    auto await_suspend(std::coroutine_handle<>) -> void
+    {
+        promise_->fail(try_access::propagate(std::forward<R>(result_)));
+    }
+
+    /**
+     * @brief Ok value of the awaited Result
+     *
+     * Moved out for an rvalue Result, borrowed from an lvalue one.
+     */
+    auto await_resume() -> std::conditional_t<
+        std::is_lvalue_reference_v<R>,
+        decltype(try_access::take_value(std::declval<R>())),
+        std::remove_cvref_t<decltype(try_access::take_value(
+            std::declval<R>()))>>
+    {
+        return try_access::take_value(std::forward<R>(result_));
+    }
+};
+
+/**
+ * @brief Promise parts shared by value and void Result coroutines
+ */
+template <typename T, typename E> class result_promise_base
+{
+protected:
+    std::optional<storage<value_or_unit_t<T>, E>> out_;
+
+    friend class coro_return<T, E>;
+
+public:
+    static auto operator new(std::size_t n) -> void *
+    {
+        return frame_arena::local().allocate(n);
+    }
+
+    static auto operator delete(void *p, std::size_t n) noexcept -> void
+    {
+        frame_arena::local().deallocate(p, n);
+    }
+
+    auto get_return_object() noexcept -> coro_return<T, E>
+    {
+        return coro_return<T, E>{
+            std::coroutine_handle<result_promise<T, E>>::from_promise(
+                static_cast<result_promise<T, E> &>(*this))};
+    }
+
+    // The body runs inside the call; the return object is converted once it
+    // has finished or stopped at a failed co_await. An exception escaping
+    // the body leaves the frame to the compiler, which frees it.
+    auto initial_suspend() noexcept -> std::suspend_never { return {}; }
+    auto final_suspend() noexcept -> std::suspend_always { return {}; }
+
+    [[noreturn]] auto unhandled_exception() -> void { throw; }
+
+    template <typename Ref>
+    auto fail(propagated_error<Ref> propagated) -> void
+    {
+        out_.emplace(ErrTag{RSTD_ERR_SITE(propagated.site)},
+                     std::forward<Ref>(propagated.error));
+    }
+
+    template <typename R>
+        requires is_result_v<R> &&
+                 std::is_constructible_v<E, decltype(try_access::propagate(
+                                                    std::declval<R>())
+                                                    .error)>
+    auto await_transform(R &&result) noexcept -> result_awaiter<R, T, E>
+    {
+        return {std::forward<R>(result),
+                static_cast<result_promise<T, E> *>(this)};
+    }
+};
+
+template <typename T, typename E>
+class result_promise : public result_promise_base<T, E>
+{
+public:
+    template <typename U = T>
+        requires std::is_constructible_v<T, U &&>
+    auto return_value(U &&value) -> void
+    {
+        this->out_.emplace(OkTag{}, std::forward<U>(value));
+    }
+
+    auto return_value(Result<T, E> &&result) -> void
+    {
+        if (result.is_ok()) {
+            this->out_.emplace(OkTag{},
+                               try_access::take_value(std::move(result)));
+        } else {
+            this->fail(try_access::propagate(std::move(result)));
+        }
+    }
+};
+
+/**
+ * @brief Promise of a Result<void, E> coroutine
+ *
+ * Falling off the end or a plain `co_return` returns Ok(); fail with
+ * `co_await Result<void, E>::Err(...)`.
+ */
+template <typename E>
+class result_promise<void, E> : public result_promise_base<void, E>
+{
+public:
+    auto return_void() -> void { this->out_.emplace(OkTag{}, Void{}); }
+};
+
+/**
+ * @brief Return object of a Result coroutine, converted into the Result
+ */
+template <typename T, typename E> class coro_return
+{
+    using handle_type = std::coroutine_handle<result_promise<T, E>>;
+
+    handle_type handle_;
+
+public:
+    explicit coro_return(handle_type handle) noexcept : handle_{handle} {}
+
+    /**
+     * @brief Build the Result from the outcome of the finished body and
+     *        release the frame
+     */
+    operator Result<T, E>() &&
+    {
+        struct destroy_on_exit
+        {
+            handle_type handle;
+            ~destroy_on_exit() { handle.destroy(); }
+        } guard{handle_};
+
+        auto &out = handle_.promise().out_;
+        if (!out.has_value()) [[unlikely]] {
+            panic::__detail::begin_panic(
+                "Result coroutine converted before its body ran", nullptr,
+                nullptr);
+        }
+        return try_access::assemble<Result<T, E>>(std::move(*out));
+    }
+};
+
+} // namespace rstd::result::__detail
+
+template <typename T, typename E, typename... Args>
+struct std::coroutine_traits<rstd::result::Result<T, E>, Args...>
+{
+    using promise_type = rstd::result::__detail::result_promise<T, E>;
+};
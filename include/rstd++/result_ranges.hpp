@@ -0,0 +1,406 @@
+#pragma once
+
+#include <concepts>
+#include <cstddef>
+#include <iterator>
+#include <optional>
+#include <ranges>
+#include <type_traits>
+#include <utility>
+
+#include "result.hpp"
+
+/**
+ * @file result_ranges.hpp
+ * @brief Range adaptors over Results and a short-circuiting collect
+ *
+ * @code
+ * auto parsed = inputs
+ *             | std::views::transform(parse_number)
+ *             | rstd::collect<std::vector>();  // Result<std::vector<int>, E>
+ *
+ * for (int n : results | rstd::views::ok_values) { ... }
+ * @endcode
+ *
+ * Everything is lazy and single-pass: each element is produced once, the
+ * adaptors never build intermediate containers, and collect stops at the
+ * first Err without evaluating the rest of the input.
+ */
+
+namespace rstd
+{
+
+namespace __detail
+{
+
+using result::__detail::result_parts;
+
+template <typename Rng>
+using range_result_t = std::remove_cvref_t<std::ranges::range_reference_t<Rng>>;
+
+/**
+ * @brief Input ranges whose elements are Results
+ */
+template <typename Rng>
+concept result_range =
+    std::ranges::input_range<Rng> &&
+    result::__detail::is_result_v<std::ranges::range_reference_t<Rng>>;
+
+/**
+ * @brief The Ok value or the error of a Result, as chosen by Ok
+ */
+template <bool Ok, typename R> constexpr auto payload(R &r) noexcept -> auto &
+{
+    if constexpr (Ok) {
+        return r.unwrap_unchecked();
+    } else {
+        return r.unwrap_err_unchecked();
+    }
+}
+
+/**
+ * @brief The begin iterator of a forward view, computed on first use
+ *
+ * As with the cache of std::views::filter, copying or moving the owning
+ * view drops the iterator instead of copying it, since it may point into
+ * the source view.
+ */
+template <typename It> class begin_cache
+{
+    std::optional<It> it_;
+
+public:
+    constexpr begin_cache() = default;
+
+    constexpr begin_cache(const begin_cache &) noexcept {}
+
+    constexpr begin_cache(begin_cache &&other) noexcept
+    {
+        other.it_.reset();
+    }
+
+    constexpr auto operator=(const begin_cache &other) noexcept
+        -> begin_cache &
+    {
+        if (this != &other) {
+            it_.reset();
+        }
+        return *this;
+    }
+
+    constexpr auto operator=(begin_cache &&other) noexcept -> begin_cache &
+    {
+        it_.reset();
+        other.it_.reset();
+        return *this;
+    }
+
+    [[nodiscard]] constexpr auto has_value() const noexcept -> bool
+    {
+        return it_.has_value();
+    }
+
+    [[nodiscard]] constexpr auto operator*() const noexcept -> const It &
+    {
+        return *it_;
+    }
+
+    constexpr auto emplace(It it) -> void { it_.emplace(std::move(it)); }
+};
+
+/**
+ * @brief View of the Ok values (Ok = true) or the errors (Ok = false) of a
+ *        range of Results, skipping the other state
+ *
+ * Over a range of lvalue Results the payloads are referenced in place and
+ * the view is as strong as the base up to forward_range. A range that
+ * yields Results by value, such as a transform, is read once per element:
+ * the payload is moved into the view and handed out as an rvalue, which
+ * makes the view an input range. Like std::views::filter, a forward view
+ * finds its first element once and caches it, so begin() is amortized
+ * constant time.
+ */
+template <std::ranges::view V, bool Ok>
+    requires result_range<V>
+class payload_view : public std::ranges::view_interface<payload_view<V, Ok>>
+{
+    using base_reference = std::ranges::range_reference_t<V>;
+    using parts = result_parts<std::remove_cvref_t<base_reference>>;
+    using payload_type =
+        std::conditional_t<Ok, typename parts::value_type,
+                           typename parts::error_type>;
+
+    static_assert(!std::is_void_v<payload_type>,
+                  "ok_values needs a Result with a value");
+
+    static constexpr bool borrowed = std::is_lvalue_reference_v<base_reference>;
+    static constexpr bool caches_begin =
+        borrowed && std::ranges::forward_range<V>;
+
+    V base_ = V();
+    [[no_unique_address]] std::conditional_t<
+        borrowed, Void, std::optional<std::remove_cvref_t<payload_type>>>
+        cache_{};
+    [[no_unique_address]] std::conditional_t<
+        caches_begin, begin_cache<std::ranges::iterator_t<V>>, Void>
+        begin_{};
+
+    /**
+     * @brief Advance @p it to the next Result in the wanted state
+     */
+    constexpr auto satisfy(std::ranges::iterator_t<V> &it) -> void
+    {
+        const auto last = std::ranges::end(base_);
+        for (; it != last; ++it) {
+            auto &&r = *it;
+            if (r.is_ok() != Ok) {
+                continue;
+            }
+            if constexpr (!borrowed) {
+                cache_.emplace(std::move(payload<Ok>(r)));
+            }
+            return;
+        }
+    }
+
+public:
+    class iterator
+    {
+        payload_view *parent_ = nullptr;
+        std::ranges::iterator_t<V> it_{};
+
+    public:
+        using iterator_concept =
+            std::conditional_t<borrowed && std::ranges::forward_range<V>,
+                               std::forward_iterator_tag,
+                               std::input_iterator_tag>;
+        using value_type = std::remove_cvref_t<payload_type>;
+        using difference_type = std::ranges::range_difference_t<V>;
+
+        iterator() = default;
+
+        constexpr iterator(payload_view &parent,
+                           std::ranges::iterator_t<V> it)
+            : parent_{&parent}, it_{std::move(it)}
+        {}
+
+        constexpr auto operator*() const -> decltype(auto)
+        {
+            if constexpr (borrowed) {
+                return payload<Ok>(*it_);
+            } else {
+                return std::move(*parent_->cache_);
+            }
+        }
+
+        constexpr auto operator++() -> iterator &
+        {
+            ++it_;
+            parent_->satisfy(it_);
+            return *this;
+        }
+
+        constexpr auto operator++(int)
+        {
+            if constexpr (std::same_as<iterator_concept,
+                                       std::forward_iterator_tag>) {
+                auto tmp = *this;
+                ++*this;
+                return tmp;
+            } else {
+                ++*this;
+            }
+        }
+
+        friend constexpr auto operator==(const iterator &lhs,
+                                         const iterator &rhs) -> bool
+            requires std::equality_comparable<std::ranges::iterator_t<V>>
+        {
+            return lhs.it_ == rhs.it_;
+        }
+
+        friend constexpr auto operator==(const iterator &it,
+                                         std::default_sentinel_t) -> bool
+        {
+            return it.at_end();
+        }
+
+    private:
+        constexpr auto at_end() const -> bool
+        {
+            return it_ == std::ranges::end(parent_->base_);
+        }
+    };
+
+    payload_view()
+        requires std::default_initializable<V>
+    = default;
+
+    constexpr explicit payload_view(V base) : base_{std::move(base)} {}
+
+    constexpr auto base() const & -> V
+        requires std::copy_constructible<V>
+    {
+        return base_;
+    }
+
+    constexpr auto base() && -> V { return std::move(base_); }
+
+    constexpr auto begin() -> iterator
+    {
+        if constexpr (caches_begin) {
+            if (begin_.has_value()) {
+                return iterator{*this, *begin_};
+            }
+        }
+        auto it = std::ranges::begin(base_);
+        satisfy(it);
+        if constexpr (caches_begin) {
+            begin_.emplace(it);
+        }
+        return iterator{*this, std::move(it)};
+    }
+
+    constexpr auto end() const noexcept -> std::default_sentinel_t
+    {
+        return std::default_sentinel;
+    }
+};
+
+template <bool Ok> struct payload_fn
+{
+    template <std::ranges::viewable_range Rng>
+        requires result_range<std::views::all_t<Rng>>
+    constexpr auto operator()(Rng &&rng) const
+    {
+        return payload_view<std::views::all_t<Rng>, Ok>(
+            std::views::all(std::forward<Rng>(rng)));
+    }
+
+    template <std::ranges::viewable_range Rng>
+        requires result_range<std::views::all_t<Rng>>
+    friend constexpr auto operator|(Rng &&rng, const payload_fn &fn)
+    {
+        return fn(std::forward<Rng>(rng));
+    }
+};
+
+template <typename Fn> struct transform_ok_fn
+{
+    Fn fn;
+
+    template <std::ranges::viewable_range Rng>
+        requires result_range<std::views::all_t<Rng>>
+    constexpr auto operator()(Rng &&rng) const
+    {
+        return std::views::transform(
+            std::forward<Rng>(rng), [fn = fn](auto &&r) {
+                return std::forward<decltype(r)>(r).map(fn);
+            });
+    }
+
+    template <std::ranges::viewable_range Rng>
+        requires result_range<std::views::all_t<Rng>>
+    friend constexpr auto operator|(Rng &&rng, const transform_ok_fn &self)
+    {
+        return self(std::forward<Rng>(rng));
+    }
+};
+
+template <template <typename...> class C> struct collect_fn
+{
+    template <std::ranges::input_range Rng>
+        requires result_range<Rng>
+    constexpr auto operator()(Rng &&rng) const
+    {
+        using parts = result_parts<range_result_t<Rng>>;
+        using T = typename parts::value_type;
+        using E = typename parts::error_type;
+        using Out = result::Result<C<T>, E>;
+
+        // An element of a range of lvalues still belongs to the range
+        constexpr bool owned =
+            !std::is_lvalue_reference_v<std::ranges::range_reference_t<Rng>>;
+
+        C<T> out;
+        if constexpr (std::ranges::sized_range<Rng> &&
+                      requires(std::size_t n) { out.reserve(n); }) {
+            out.reserve(static_cast<std::size_t>(std::ranges::size(rng)));
+        }
+        const auto append = [&out]<typename U>(U &&value) {
+            if constexpr (requires { out.push_back(std::forward<U>(value)); }) {
+                out.push_back(std::forward<U>(value));
+            } else {
+                out.insert(out.end(), std::forward<U>(value));
+            }
+        };
+        for (auto &&r : rng) {
+            if constexpr (owned) {
+                if (r.is_err()) {
+                    return Out::Err(std::move(r.unwrap_err_unchecked()));
+                }
+                append(std::move(r.unwrap_unchecked()));
+            } else {
+                if (r.is_err()) {
+                    return Out::Err(r.unwrap_err_unchecked());
+                }
+                append(r.unwrap_unchecked());
+            }
+        }
+        return Out::Ok(std::move(out));
+    }
+
+    template <std::ranges::input_range Rng>
+        requires result_range<Rng>
+    friend constexpr auto operator|(Rng &&rng, const collect_fn &fn)
+    {
+        return fn(std::forward<Rng>(rng));
+    }
+};
+
+} // namespace __detail
+
+namespace views
+{
+
+/**
+ * @brief The values of the Ok elements of a range of Results
+ */
+inline constexpr __detail::payload_fn<true> ok_values{};
+
+/**
+ * @brief The errors of the Err elements of a range of Results
+ */
+inline constexpr __detail::payload_fn<false> err_values{};
+
+/**
+ * @brief Lazily map the Ok values of a range of Results, passing errors
+ *        through: `r | transform_ok(fn)` yields `r[i].map(fn)`
+ */
+template <typename Fn> constexpr auto transform_ok(Fn &&fn)
+{
+    return __detail::transform_ok_fn<std::decay_t<Fn>>{std::forward<Fn>(fn)};
+}
+
+} // namespace views
+
+/**
+ * @brief Gather a range of Result<T, E> into Result<C<T>, E>
+ *
+ * Stops at the first Err and returns it. The container is reserved when the
+ * input is sized, and values produced by the range are moved straight into
+ * it. Use as `rng | collect<std::vector>()` or `collect<std::vector>(rng)`.
+ */
+template <template <typename...> class C> constexpr auto collect()
+{
+    return __detail::collect_fn<C>{};
+}
+
+template <template <typename...> class C, std::ranges::input_range Rng>
+    requires __detail::result_range<Rng>
+constexpr auto collect(Rng &&rng)
+{
+    return __detail::collect_fn<C>{}(std::forward<Rng>(rng));
+}
+
+} // namespace rstd
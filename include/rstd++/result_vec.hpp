@@ -0,0 +1,407 @@
+#pragma once
+
+#include <algorithm>
+#include <bit>
+#include <concepts>
+#include <cstddef>
+#include <cstdint>
+#include <functional>
+#include <optional>
+#include <ranges>
+#include <span>
+#include <type_traits>
+#include <utility>
+#include <vector>
+
+#include "result.hpp"
+
+/**
+ * @file result_vec.hpp
+ * @brief A batch of Result<T, E> stored as a struct of arrays
+ *
+ * A std::vector of Result interleaves discriminants and payloads, so a loop
+ * over the values has to branch on every element. ResultVec keeps
+ *
+ *  - every value in one contiguous array, Err lanes holding a
+ *    value-initialized T,
+ *  - a bitmap with one bit per lane, set for Ok,
+ *  - the errors in a separate array, sparse and ordered by lane.
+ *
+ * The batch operations then become straight loops over plain arrays that
+ * the compiler vectorizes: map walks the bitmap a word at a time and runs
+ * a branch-free loop over every word whose 64 lanes are all Ok, map_err
+ * only visits the errors, and count_ok is a popcount over the bitmap.
+ */
+
+namespace rstd
+{
+
+/**
+ * @brief Value types a ResultVec can hold in its contiguous array
+ *
+ * bool is excluded because std::vector<bool> is not contiguous.
+ */
+template <typename T>
+concept batch_value = std::is_object_v<T> && !std::is_const_v<T> &&
+                      std::is_default_constructible_v<T> &&
+                      !std::same_as<T, bool>;
+
+namespace __detail
+{
+
+/**
+ * @brief Element type produced by applying Fn to the elements of an array
+ *        of A
+ */
+template <typename Fn, typename A>
+using batch_result_t =
+    std::remove_cvref_t<std::invoke_result_t<Fn &, const A &>>;
+
+} // namespace __detail
+
+template <typename T, typename E>
+    requires batch_value<T>
+class ResultVec
+{
+    static constexpr std::size_t word_bits = 64;
+
+    std::vector<T> values_;
+    std::vector<std::uint64_t> ok_bits_;
+    std::vector<std::size_t> err_lanes_;
+    std::vector<E> errors_;
+
+    template <typename U, typename G>
+        requires batch_value<U>
+    friend class ResultVec;
+
+    /**
+     * @brief Record the bit of the lane just pushed to values_
+     */
+    auto push_bit(bool ok) -> void
+    {
+        const std::size_t lane = values_.size() - 1;
+        if (lane % word_bits == 0) {
+            ok_bits_.push_back(0);
+        }
+        ok_bits_.back() |= std::uint64_t{ok} << (lane % word_bits);
+    }
+
+public:
+    using value_type = T;
+    using error_type = E;
+    using result_type = result::Result<T, E>;
+    using collected_type = result::Result<std::vector<T>, E>;
+
+    ResultVec() = default;
+
+    /**
+     * @brief Gather a range of Results into a batch
+     */
+    template <std::ranges::input_range R>
+        requires std::same_as<std::ranges::range_value_t<R>, result_type>
+    explicit ResultVec(R &&results)
+    {
+        if constexpr (std::ranges::sized_range<R>) {
+            reserve(std::ranges::size(results));
+        }
+        for (auto &&r : results) {
+            push_back(std::forward<decltype(r)>(r));
+        }
+    }
+
+    auto reserve(std::size_t n) -> void
+    {
+        values_.reserve(n);
+        ok_bits_.reserve((n + word_bits - 1) / word_bits);
+    }
+
+    /**
+     * @brief Append an Ok lane
+     *
+     * The payload is pushed before the bit, and popped again if the bitmap
+     * fails to grow, so a throw leaves the batch unchanged.
+     */
+    auto push_ok(T value) -> void
+    {
+        values_.push_back(std::move(value));
+        try {
+            push_bit(true);
+        } catch (...) {
+            values_.pop_back();
+            throw;
+        }
+    }
+
+    /**
+     * @brief Append an Err lane; a throw leaves the batch unchanged
+     */
+    auto push_err(E error) -> void
+    {
+        const std::size_t lane = values_.size();
+        errors_.push_back(std::move(error));
+        try {
+            err_lanes_.push_back(lane);
+            values_.emplace_back();
+            push_bit(false);
+        } catch (...) {
+            if (values_.size() != lane) {
+                values_.pop_back();
+            }
+            if (err_lanes_.size() == errors_.size()) {
+                err_lanes_.pop_back();
+            }
+            errors_.pop_back();
+            throw;
+        }
+    }
+
+    auto push_back(const result_type &r) -> void
+    {
+        if (r.is_ok()) {
+            push_ok(r.unwrap_unchecked());
+        } else {
+            push_err(r.unwrap_err_unchecked());
+        }
+    }
+
+    auto push_back(result_type &&r) -> void
+    {
+        if (r.is_ok()) {
+            push_ok(std::move(r).unwrap_unchecked());
+        } else {
+            push_err(std::move(r).unwrap_err_unchecked());
+        }
+    }
+
+    [[nodiscard]] auto size() const noexcept -> std::size_t
+    {
+        return values_.size();
+    }
+
+    [[nodiscard]] auto empty() const noexcept -> bool
+    {
+        return values_.empty();
+    }
+
+    [[nodiscard]] auto is_ok(std::size_t lane) const noexcept -> bool
+    {
+        return ((ok_bits_[lane / word_bits] >> (lane % word_bits)) & 1) != 0;
+    }
+
+    [[nodiscard]] auto is_err(std::size_t lane) const noexcept -> bool
+    {
+        return !is_ok(lane);
+    }
+
+    /**
+     * @brief The error of an Err lane; panics for an Ok or missing lane
+     */
+    [[nodiscard]] auto error(std::size_t lane) const noexcept -> const E &
+    {
+        const auto it =
+            std::lower_bound(err_lanes_.begin(), err_lanes_.end(), lane);
+        if (it == err_lanes_.end() || *it != lane) [[unlikely]] {
+            panic::__detail::begin_panic(
+                "called `ResultVec::error()` on a lane that is not Err",
+                nullptr, nullptr);
+        }
+        return errors_[static_cast<std::size_t>(it - err_lanes_.begin())];
+    }
+
+    /**
+     * @brief Copy one lane out as a Result
+     */
+    [[nodiscard]] auto get(std::size_t lane) const -> result_type
+    {
+        if (is_ok(lane)) {
+            return result_type::Ok(values_[lane]);
+        }
+        return result_type::Err(error(lane));
+    }
+
+    /**
+     * @brief Every value lane; Err lanes hold a value-initialized T
+     */
+    [[nodiscard]] auto values() const noexcept -> std::span<const T>
+    {
+        return values_;
+    }
+
+    /**
+     * @brief Validity bitmap: bit i of word i / 64 is set for an Ok lane
+     */
+    [[nodiscard]] auto ok_bits() const noexcept
+        -> std::span<const std::uint64_t>
+    {
+        return ok_bits_;
+    }
+
+    /**
+     * @brief The errors, in lane order
+     */
+    [[nodiscard]] auto errors() const noexcept -> std::span<const E>
+    {
+        return errors_;
+    }
+
+    /**
+     * @brief The lane of each entry of errors()
+     */
+    [[nodiscard]] auto err_lanes() const noexcept
+        -> std::span<const std::size_t>
+    {
+        return err_lanes_;
+    }
+
+    // ======================================================================
+    // Batch queries
+    // ======================================================================
+
+    [[nodiscard]] auto count_ok() const noexcept -> std::size_t
+    {
+        std::size_t n = 0;
+        for (const std::uint64_t word : ok_bits_) {
+            n += static_cast<std::size_t>(std::popcount(word));
+        }
+        return n;
+    }
+
+    [[nodiscard]] auto count_err() const noexcept -> std::size_t
+    {
+        return errors_.size();
+    }
+
+    [[nodiscard]] auto all_ok() const noexcept -> bool
+    {
+        return errors_.empty();
+    }
+
+    /**
+     * @brief Lane of the first Err, or nullopt if every lane is Ok
+     */
+    [[nodiscard]] auto first_err() const noexcept -> std::optional<std::size_t>
+    {
+        if (errors_.empty()) {
+            return std::nullopt;
+        }
+        return err_lanes_.front();
+    }
+
+    // ======================================================================
+    // Batch combinators
+    // ======================================================================
+
+    /**
+     * @brief Apply @p fn to every Ok lane
+     *
+     * @p fn is never called on the placeholder of an Err lane, which gets a
+     * value-initialized U instead. Runs of 64 Ok lanes go through a loop
+     * with no per-lane branch, so that dense batches still vectorize.
+     */
+    template <typename Fn, typename U = __detail::batch_result_t<Fn, T>>
+        requires batch_value<U>
+    [[nodiscard]] auto map(Fn &&fn) const & -> ResultVec<U, E>
+    {
+        ResultVec<U, E> out;
+        out.values_.resize(values_.size());
+        map_values(out.values_, fn);
+        out.ok_bits_ = ok_bits_;
+        out.err_lanes_ = err_lanes_;
+        out.errors_ = errors_;
+        return out;
+    }
+
+    template <typename Fn, typename U = __detail::batch_result_t<Fn, T>>
+        requires batch_value<U>
+    [[nodiscard]] auto map(Fn &&fn) && -> ResultVec<U, E>
+    {
+        ResultVec<U, E> out;
+        out.values_.resize(values_.size());
+        map_values(out.values_, fn);
+        out.ok_bits_ = std::move(ok_bits_);
+        out.err_lanes_ = std::move(err_lanes_);
+        out.errors_ = std::move(errors_);
+        return out;
+    }
+
+    /**
+     * @brief Apply @p fn to every error; the value lanes are untouched
+     */
+    template <typename Fn, typename G = __detail::batch_result_t<Fn, E>>
+    [[nodiscard]] auto map_err(Fn &&fn) const & -> ResultVec<T, G>
+    {
+        ResultVec<T, G> out;
+        out.values_ = values_;
+        out.ok_bits_ = ok_bits_;
+        out.err_lanes_ = err_lanes_;
+        map_errors(out.errors_, fn);
+        return out;
+    }
+
+    template <typename Fn, typename G = __detail::batch_result_t<Fn, E>>
+    [[nodiscard]] auto map_err(Fn &&fn) && -> ResultVec<T, G>
+    {
+        ResultVec<T, G> out;
+        out.values_ = std::move(values_);
+        out.ok_bits_ = std::move(ok_bits_);
+        out.err_lanes_ = std::move(err_lanes_);
+        map_errors(out.errors_, fn);
+        return out;
+    }
+
+    /**
+     * @brief All values if every lane is Ok, otherwise the first error
+     */
+    [[nodiscard]] auto collect() const & -> collected_type
+    {
+        if (!errors_.empty()) {
+            return collected_type::Err(errors_.front());
+        }
+        return collected_type::Ok(values_);
+    }
+
+    [[nodiscard]] auto collect() && -> collected_type
+    {
+        if (!errors_.empty()) {
+            return collected_type::Err(std::move(errors_.front()));
+        }
+        return collected_type::Ok(std::move(values_));
+    }
+
+private:
+    template <typename U, typename Fn>
+    auto map_values(std::vector<U> &out, Fn &fn) const -> void
+    {
+        const T *in = values_.data();
+        U *dst = out.data();
+        const std::size_t n = values_.size();
+        for (std::size_t w = 0; w < ok_bits_.size(); ++w) {
+            const std::size_t base = w * word_bits;
+            const std::size_t lanes = std::min(word_bits, n - base);
+            std::uint64_t word = ok_bits_[w];
+            if (word == ~std::uint64_t{0}) {
+                for (std::size_t i = base; i < base + lanes; ++i) {
+                    dst[i] = std::invoke(fn, in[i]);
+                }
+                continue;
+            }
+            while (word != 0) {
+                const auto i = base + static_cast<std::size_t>(
+                                          std::countr_zero(word));
+                dst[i] = std::invoke(fn, in[i]);
+                word &= word - 1;
+            }
+        }
+    }
+
+    template <typename G, typename Fn>
+    auto map_errors(std::vector<G> &out, Fn &fn) const -> void
+    {
+        out.reserve(errors_.size());
+        for (const E &e : errors_) {
+            out.push_back(std::invoke(fn, e));
+        }
+    }
+};
+
+} // namespace rstd
@@ -0,0 +1,873 @@
+#pragma once
+
+#include <coroutine>
+#include <cstddef>
+#include <deque>
+#include <exception>
+#include <memory>
+#include <new>
+#include <optional>
+#include <type_traits>
+#include <utility>
+
+#include "panic.hpp"
+#include "result.hpp"
+
+/**
+ * @file task.hpp
+ * @brief Lazy coroutine tasks that complete with a Result
+ *
+ * A function returning Task<T, E> is a coroutine that starts when it is
+ * awaited or run on an executor and finishes with a Result<T, E>. Inside it
+ * `co_await` works on Results and on other Tasks alike: an Ok yields its
+ * value, an Err ends the task with that error, converted to E.
+ *
+ * @code
+ * auto load(Id id) -> rstd::Task<Record, Error>
+ * {
+ *     Bytes raw = co_await fetch(id);   // Task<Bytes, Error>
+ *     Record rec = co_await parse(raw); // Result<Record, Error>
+ *     co_return rec;
+ * }
+ *
+ * rstd::EventLoop loop;
+ * Result<Record, Error> r = loop.block_on(load(42));
+ * @endcode
+ *
+ * Control passes between tasks by symmetric transfer, so long chains of
+ * awaits do not grow the stack, and an Err is handed up the chain of
+ * awaiting tasks without resuming any of them. Exceptions are carried
+ * through the chain and rethrown where the outcome is read.
+ *
+ * Frames come from a per-thread FramePool that recycles released frames by
+ * size, so a thread serving requests of the same shape stops allocating
+ * once warm. A coroutine whose parameters start with a std::allocator_arg_t
+ * and an allocator, both taken by value, allocates its frame from that
+ * allocator instead.
+ */
+
+#ifndef RSTD_TASK_FRAME_POOL_LIMIT
+#define RSTD_TASK_FRAME_POOL_LIMIT 4096
+#endif
+
+namespace rstd
+{
+
+template <typename T, typename E> class Task;
+class EventLoop;
+
+/**
+ * @brief Per-thread free lists of coroutine frames, by size class
+ *
+ * Sizes up to RSTD_TASK_FRAME_POOL_LIMIT bytes are rounded up to a multiple
+ * of 64, and released blocks are kept for the next frame of that class.
+ * A block released on another thread joins that thread's lists. Larger
+ * frames go straight to operator new, and so does every frame allocated
+ * or released on a thread whose pool has already been destroyed, e.g. by
+ * the destructor of another thread_local.
+ */
+class FramePool
+{
+    static constexpr std::size_t granularity = 64;
+    static constexpr std::size_t limit = RSTD_TASK_FRAME_POOL_LIMIT;
+    static constexpr std::size_t classes =
+        (limit + granularity - 1) / granularity;
+
+    struct free_block
+    {
+        free_block *next;
+    };
+
+    free_block *free_[classes] = {};
+    std::size_t heap_allocations_ = 0;
+    bool thread_pool_ = false;
+
+    struct thread_tag
+    {};
+
+    explicit FramePool(thread_tag) noexcept : thread_pool_{true} {}
+
+    // Trivially destructible, so it stays readable after the pool is gone
+    static auto torn_down_flag() noexcept -> bool &
+    {
+        thread_local bool torn_down = false;
+        return torn_down;
+    }
+
+    static constexpr auto size_class(std::size_t n) noexcept -> std::size_t
+    {
+        return (n + granularity - 1) / granularity - 1;
+    }
+
+public:
+    FramePool() = default;
+    FramePool(const FramePool &) = delete;
+    auto operator=(const FramePool &) -> FramePool & = delete;
+
+    ~FramePool()
+    {
+        if (thread_pool_) {
+            torn_down_flag() = true;
+        }
+        for (free_block *&head : free_) {
+            while (head != nullptr) {
+                ::operator delete(std::exchange(head, head->next));
+            }
+        }
+    }
+
+    auto allocate(std::size_t n) -> void *
+    {
+        if (n <= limit && free_[size_class(n)] != nullptr) {
+            free_block *&head = free_[size_class(n)];
+            return std::exchange(head, head->next);
+        }
+        ++heap_allocations_;
+        if (n > limit) {
+            return ::operator new(n);
+        }
+        return ::operator new((size_class(n) + 1) * granularity);
+    }
+
+    auto deallocate(void *p, std::size_t n) noexcept -> void
+    {
+        if (n > limit) {
+            ::operator delete(p);
+            return;
+        }
+        free_block *&head = free_[size_class(n)];
+        head = ::new (p) free_block{head};
+    }
+
+    /**
+     * @brief Number of allocations this pool could not serve from its lists
+     */
+    [[nodiscard]] auto heap_allocations() const noexcept -> std::size_t
+    {
+        return heap_allocations_;
+    }
+
+    /**
+     * @brief The calling thread's pool; must not be used once torn_down()
+     */
+    static auto local() noexcept -> FramePool &
+    {
+        thread_local FramePool pool{thread_tag{}};
+        return pool;
+    }
+
+    /**
+     * @brief Whether the calling thread's pool has been destroyed
+     */
+    [[nodiscard]] static auto torn_down() noexcept -> bool
+    {
+        return torn_down_flag();
+    }
+};
+
+namespace __detail
+{
+
+using result::__detail::propagated_error;
+using result::__detail::storage;
+using result::__detail::try_access;
+using result::__detail::value_or_unit_t;
+
+template <typename T, typename E> class task_promise;
+template <typename U, typename G, typename P> class task_awaiter;
+template <typename U, typename G> class task_outcome_awaiter;
+template <typename T, typename E, typename Alloc, typename... Args>
+class allocating_promise;
+template <typename T, typename E, typename Self, typename Alloc,
+          typename... Args>
+class allocating_method_promise;
+
+/**
+ * @brief Frees a frame of @p n bytes; stored right behind the frame
+ */
+using frame_release = void (*)(void *frame, std::size_t n) noexcept;
+
+constexpr auto align_up(std::size_t n, std::size_t align) noexcept
+    -> std::size_t
+{
+    return (n + align - 1) / align * align;
+}
+
+constexpr auto release_offset(std::size_t n) noexcept -> std::size_t
+{
+    return align_up(n, alignof(frame_release));
+}
+
+inline auto release_slot(void *frame, std::size_t n) noexcept
+    -> frame_release *
+{
+    return reinterpret_cast<frame_release *>(static_cast<std::byte *>(frame) +
+                                             release_offset(n));
+}
+
+/**
+ * @brief Frames allocated from the thread's FramePool
+ */
+struct pool_frame
+{
+    static constexpr auto size(std::size_t n) noexcept -> std::size_t
+    {
+        return release_offset(n) + sizeof(frame_release);
+    }
+
+    static auto allocate(std::size_t n) -> void *
+    {
+        void *p = FramePool::torn_down()
+                      ? ::operator new(size(n))
+                      : FramePool::local().allocate(size(n));
+        ::new (release_slot(p, n)) frame_release(&release);
+        return p;
+    }
+
+    static auto release(void *p, std::size_t n) noexcept -> void
+    {
+        if (FramePool::torn_down()) {
+            ::operator delete(p);
+        } else {
+            FramePool::local().deallocate(p, size(n));
+        }
+    }
+};
+
+/**
+ * @brief Frames allocated from a user allocator, which is kept behind the
+ *        frame until it is released
+ */
+template <typename Alloc> struct allocator_frame
+{
+    struct alignas(__STDCPP_DEFAULT_NEW_ALIGNMENT__) block
+    {
+        std::byte bytes[__STDCPP_DEFAULT_NEW_ALIGNMENT__];
+    };
+
+    using alloc_type =
+        typename std::allocator_traits<Alloc>::template rebind_alloc<block>;
+    using traits = std::allocator_traits<alloc_type>;
+
+    static constexpr auto alloc_offset(std::size_t n) noexcept -> std::size_t
+    {
+        return align_up(release_offset(n) + sizeof(frame_release),
+                        alignof(alloc_type));
+    }
+
+    static constexpr auto blocks(std::size_t n) noexcept -> std::size_t
+    {
+        return (alloc_offset(n) + sizeof(alloc_type) + sizeof(block) - 1) /
+               sizeof(block);
+    }
+
+    static auto alloc_slot(void *frame, std::size_t n) noexcept
+        -> alloc_type *
+    {
+        return reinterpret_cast<alloc_type *>(static_cast<std::byte *>(frame) +
+                                              alloc_offset(n));
+    }
+
+    static auto allocate(std::size_t n, const Alloc &alloc) -> void *
+    {
+        alloc_type a(alloc);
+        void *p = std::to_address(traits::allocate(a, blocks(n)));
+        ::new (alloc_slot(p, n)) alloc_type(std::move(a));
+        ::new (release_slot(p, n)) frame_release(&release);
+        return p;
+    }
+
+    static auto release(void *p, std::size_t n) noexcept -> void
+    {
+        alloc_type *stored = std::launder(alloc_slot(p, n));
+        alloc_type a(std::move(*stored));
+        stored->~alloc_type();
+        traits::deallocate(a, static_cast<block *>(p), blocks(n));
+    }
+};
+
+/**
+ * @brief Promise parts that do not depend on the Result type: frame
+ *        allocation, the awaiting coroutine and how a failure leaves
+ */
+class task_frame
+{
+public:
+    std::coroutine_handle<> continuation_ = std::noop_coroutine();
+
+    // Set while awaited by another task: hands this task's error to it
+    std::coroutine_handle<> (*fail_parent_)(void *awaiter) noexcept = nullptr;
+    void *awaiter_ = nullptr;
+
+    std::exception_ptr exception_;
+    bool failed_ = false;
+
+    struct final_awaiter
+    {
+        [[nodiscard]] auto await_ready() const noexcept -> bool
+        {
+            return false;
+        }
+
+        template <typename P>
+        auto await_suspend(std::coroutine_handle<P> self) noexcept
+            -> std::coroutine_handle<>
+        {
+            return self.promise().complete();
+        }
+
+        auto await_resume() const noexcept -> void {}
+    };
+
+    static auto operator new(std::size_t n) -> void *
+    {
+        return pool_frame::allocate(n);
+    }
+
+    static auto operator delete(void *p, std::size_t n) noexcept -> void
+    {
+        (*std::launder(release_slot(p, n)))(p, n);
+    }
+
+    auto initial_suspend() noexcept -> std::suspend_always { return {}; }
+    auto final_suspend() noexcept -> final_awaiter { return {}; }
+
+    auto unhandled_exception() noexcept -> void
+    {
+        exception_ = std::current_exception();
+    }
+
+    /**
+     * @brief Where control goes once the task has returned or failed
+     *
+     * A failed task that is awaited by another one gives it the error, and
+     * that task completes the same way, so an Err unwinds the whole chain
+     * of awaiting tasks without resuming them.
+     */
+    auto complete() noexcept -> std::coroutine_handle<>
+    {
+        if (failed_ && fail_parent_ != nullptr) {
+            return fail_parent_(awaiter_);
+        }
+        return continuation_;
+    }
+};
+
+/**
+ * @brief Suspends a task on co_await of an Err Result
+ */
+template <typename R, typename P> class task_result_awaiter
+{
+    R &&result_;
+    P *promise_;
+
+public:
+    task_result_awaiter(R &&result, P *promise) noexcept
+        : result_{std::forward<R>(result)}, promise_{promise}
+    {}
+
+    [[nodiscard]] auto await_ready() const noexcept -> bool
+    {
+        return result_.is_ok();
+    }
+
+    auto await_suspend(std::coroutine_handle<>) -> std::coroutine_handle<>
+    {
+        promise_->fail(try_access::propagate(std::forward<R>(result_)));
+        return promise_->complete();
+    }
+
+    /**
+     * @brief Ok value of the awaited Result
+     *
+     * Moved out for an rvalue Result, borrowed from an lvalue one.
+     */
+    auto await_resume() -> std::conditional_t<
+        std::is_lvalue_reference_v<R>,
+        decltype(try_access::take_value(std::declval<R>())),
+        std::remove_cvref_t<decltype(try_access::take_value(
+            std::declval<R>()))>>
+    {
+        return try_access::take_value(std::forward<R>(result_));
+    }
+};
+
+/**
+ * @brief Runs an awaited Task<U, G> and yields its Ok value to the task
+ *        with promise P, or fails that task with its error
+ */
+template <typename U, typename G, typename P> class task_awaiter
+{
+    Task<U, G> &task_;
+    P *parent_;
+    std::coroutine_handle<> parent_handle_;
+
+    static auto fail_parent(void *self) noexcept -> std::coroutine_handle<>
+    {
+        auto &awaiter = *static_cast<task_awaiter *>(self);
+        auto &child = *awaiter.task_.promise_;
+        auto &out = *child.out_;
+        try {
+            awaiter.parent_->fail(propagated_error<G &&>{
+                std::move(out).error(), RSTD_ERR_SITE(out.site())});
+        } catch (...) {
+            // Converting the error threw: resume the parent to rethrow it
+            child.exception_ = std::current_exception();
+            return awaiter.parent_handle_;
+        }
+        return awaiter.parent_->complete();
+    }
+
+public:
+    task_awaiter(Task<U, G> &task, P *parent) noexcept
+        : task_{task}, parent_{parent}
+    {}
+
+    [[nodiscard]] auto await_ready() const noexcept -> bool { return false; }
+
+    auto await_suspend(std::coroutine_handle<> parent) noexcept
+        -> std::coroutine_handle<>
+    {
+        parent_handle_ = parent;
+        auto &child = *task_.promise_;
+        child.continuation_ = parent;
+        child.fail_parent_ = &fail_parent;
+        child.awaiter_ = this;
+        return task_.handle_;
+    }
+
+    auto await_resume() -> U
+    {
+        auto &child = *task_.promise_;
+        if (child.exception_) {
+            std::rethrow_exception(child.exception_);
+        }
+        if constexpr (!std::is_void_v<U>) {
+            return std::move(*child.out_).value();
+        }
+    }
+};
+
+/**
+ * @brief Runs an awaited task and yields its whole Result, Ok or Err
+ */
+template <typename U, typename G> class task_outcome_awaiter
+{
+    Task<U, G> task_;
+
+public:
+    explicit task_outcome_awaiter(Task<U, G> &&task) noexcept
+        : task_{std::move(task)}
+    {}
+
+    [[nodiscard]] auto await_ready() const noexcept -> bool { return false; }
+
+    auto await_suspend(std::coroutine_handle<> parent) noexcept
+        -> std::coroutine_handle<>
+    {
+        task_.promise_->continuation_ = parent;
+        return task_.handle_;
+    }
+
+    auto await_resume() -> result::Result<U, G>
+    {
+        return std::move(task_).result();
+    }
+};
+
+template <typename> struct is_task_helper : std::false_type
+{};
+
+template <typename U, typename G>
+struct is_task_helper<Task<U, G>> : std::true_type
+{};
+
+template <typename T>
+concept is_task_v = is_task_helper<std::remove_cvref_t<T>>::value;
+
+/**
+ * @brief Promise parts shared by value and void tasks
+ */
+template <typename T, typename E> class task_promise_base : public task_frame
+{
+public:
+    std::optional<storage<value_or_unit_t<T>, E>> out_;
+
+    auto get_return_object() noexcept -> Task<T, E>
+    {
+        auto &self = static_cast<task_promise<T, E> &>(*this);
+        return Task<T, E>{
+            std::coroutine_handle<task_promise<T, E>>::from_promise(self),
+            &self};
+    }
+
+    template <typename Ref>
+    auto fail(propagated_error<Ref> propagated) -> void
+    {
+        out_.emplace(result::__detail::ErrTag{RSTD_ERR_SITE(propagated.site)},
+                     std::in_place, std::forward<Ref>(propagated.error));
+        failed_ = true;
+    }
+
+    template <typename R>
+        requires result::__detail::is_result_v<R> &&
+                 std::is_constructible_v<E, decltype(try_access::propagate(
+                                                    std::declval<R>())
+                                                    .error)>
+    auto await_transform(R &&result) noexcept
+        -> task_result_awaiter<R, task_promise<T, E>>
+    {
+        return {std::forward<R>(result),
+                static_cast<task_promise<T, E> *>(this)};
+    }
+
+    template <typename U, typename G>
+        requires std::is_constructible_v<E, G &&>
+    auto await_transform(Task<U, G> &task) noexcept
+        -> task_awaiter<U, G, task_promise<T, E>>
+    {
+        return {task, static_cast<task_promise<T, E> *>(this)};
+    }
+
+    template <typename U, typename G>
+        requires std::is_constructible_v<E, G &&>
+    auto await_transform(Task<U, G> &&task) noexcept
+        -> task_awaiter<U, G, task_promise<T, E>>
+    {
+        return {task, static_cast<task_promise<T, E> *>(this)};
+    }
+
+    /**
+     * @brief Any other awaitable, such as EventLoop::schedule(), as is
+     */
+    template <typename A>
+        requires(!result::__detail::is_result_v<A> && !is_task_v<A>)
+    auto await_transform(A &&awaitable) noexcept -> A &&
+    {
+        return std::forward<A>(awaitable);
+    }
+};
+
+template <typename T, typename E>
+class task_promise : public task_promise_base<T, E>
+{
+public:
+    template <typename U = T>
+        requires std::is_constructible_v<T, U &&>
+    auto return_value(U &&value) -> void
+    {
+        this->out_.emplace(result::__detail::OkTag{}, std::forward<U>(value));
+    }
+
+    auto return_value(result::Result<T, E> &&result) -> void
+    {
+        if (result.is_ok()) {
+            this->out_.emplace(result::__detail::OkTag{},
+                               try_access::take_value(std::move(result)));
+        } else {
+            this->fail(try_access::propagate(std::move(result)));
+        }
+    }
+};
+
+/**
+ * @brief Promise of a Task<void, E>
+ *
+ * Falling off the end or a plain `co_return` completes with Ok(); fail
+ * with `co_await Result<void, E>::Err(...)`.
+ */
+template <typename E>
+class task_promise<void, E> : public task_promise_base<void, E>
+{
+public:
+    auto return_void() -> void
+    {
+        this->out_.emplace(result::__detail::OkTag{}, Void{});
+    }
+};
+
+/**
+ * @brief Promise of a Task coroutine called as
+ *        `f(std::allocator_arg, alloc, args...)`, whose frame comes from
+ *        `alloc`
+ *
+ * The allocation functions are not templates and sit next to the
+ * deallocation function, which GCC needs to pair them up.
+ */
+template <typename T, typename E, typename Alloc, typename... Args>
+class allocating_promise : public task_promise<T, E>
+{
+public:
+    static auto operator new(std::size_t n, std::allocator_arg_t,
+                             const Alloc &alloc, const Args &...) -> void *
+    {
+        return allocator_frame<Alloc>::allocate(n, alloc);
+    }
+
+    static auto operator delete(void *p, std::size_t n) noexcept -> void
+    {
+        task_frame::operator delete(p, n);
+    }
+
+    auto get_return_object() noexcept -> Task<T, E>
+    {
+        return Task<T, E>{
+            std::coroutine_handle<allocating_promise>::from_promise(*this),
+            this};
+    }
+};
+
+/**
+ * @brief Same for member functions and lambdas, whose first argument is the
+ *        object
+ */
+template <typename T, typename E, typename Self, typename Alloc,
+          typename... Args>
+class allocating_method_promise : public task_promise<T, E>
+{
+public:
+    static auto operator new(std::size_t n, const Self &, std::allocator_arg_t,
+                             const Alloc &alloc, const Args &...) -> void *
+    {
+        return allocator_frame<Alloc>::allocate(n, alloc);
+    }
+
+    static auto operator delete(void *p, std::size_t n) noexcept -> void
+    {
+        task_frame::operator delete(p, n);
+    }
+
+    auto get_return_object() noexcept -> Task<T, E>
+    {
+        return Task<T, E>{std::coroutine_handle<
+                              allocating_method_promise>::from_promise(*this),
+                          this};
+    }
+};
+
+} // namespace __detail
+
+/**
+ * @brief Lazily started coroutine that completes with a Result<T, E>
+ *
+ * Start it by awaiting it from another Task, which yields the Ok value and
+ * fails the awaiting task on an Err, or by running it on an EventLoop.
+ * `co_await std::move(task).as_result()` yields the whole Result instead.
+ */
+template <typename T, typename E>
+class [[nodiscard("Task does nothing unless awaited or run")]] Task
+{
+public:
+    using promise_type = __detail::task_promise<T, E>;
+    using result_type = result::Result<T, E>;
+
+private:
+    // The promise may be a subclass of promise_type chosen by the
+    // coroutine_traits specializations below
+    std::coroutine_handle<> handle_;
+    promise_type *promise_ = nullptr;
+
+    Task(std::coroutine_handle<> handle, promise_type *promise) noexcept
+        : handle_{handle}, promise_{promise}
+    {}
+
+    friend class __detail::task_promise_base<T, E>;
+    template <typename, typename, typename, typename...>
+    friend class __detail::allocating_promise;
+    template <typename, typename, typename, typename, typename...>
+    friend class __detail::allocating_method_promise;
+    template <typename, typename, typename>
+    friend class __detail::task_awaiter;
+    friend class __detail::task_outcome_awaiter<T, E>;
+    friend class EventLoop;
+
+public:
+    Task(Task &&other) noexcept
+        : handle_{std::exchange(other.handle_, {})},
+          promise_{std::exchange(other.promise_, nullptr)}
+    {}
+
+    auto operator=(Task &&other) noexcept -> Task &
+    {
+        if (this != &other) {
+            if (handle_) {
+                handle_.destroy();
+            }
+            handle_ = std::exchange(other.handle_, {});
+            promise_ = std::exchange(other.promise_, nullptr);
+        }
+        return *this;
+    }
+
+    ~Task()
+    {
+        if (handle_) {
+            handle_.destroy();
+        }
+    }
+
+    /**
+     * @brief Whether the task has returned, failed or thrown
+     *
+     * A task that failed at a co_await stays suspended there; its frame is
+     * released with the Task. Panics on a moved-from Task.
+     */
+    [[nodiscard]] auto done() const noexcept -> bool
+    {
+        if (promise_ == nullptr) [[unlikely]] {
+            panic::__detail::begin_panic("called `Task::done()` on a "
+                                         "moved-from Task",
+                                         nullptr, nullptr);
+        }
+        return handle_.done() || promise_->failed_;
+    }
+
+    /**
+     * @brief Outcome of the finished task; rethrows an escaped exception
+     *
+     * Panics if the task has not finished.
+     */
+    auto result() && -> result_type
+    {
+        if (!done()) [[unlikely]] {
+            panic::__detail::begin_panic(
+                "called `Task::result()` before the task finished", nullptr,
+                nullptr);
+        }
+        auto &promise = *promise_;
+        if (promise.exception_) {
+            std::rethrow_exception(promise.exception_);
+        }
+        return __detail::try_access::assemble<result_type>(
+            std::move(*promise.out_));
+    }
+
+    /**
+     * @brief Awaitable yielding the whole Result without failing the
+     *        awaiting task on an Err
+     */
+    auto as_result() && noexcept -> __detail::task_outcome_awaiter<T, E>
+    {
+        return __detail::task_outcome_awaiter<T, E>{std::move(*this)};
+    }
+};
+
+/**
+ * @brief Single-threaded executor: a queue of coroutines ready to resume
+ *
+ * Meant for tests and simple programs. Tasks hand the thread to each other
+ * with `co_await loop.schedule()`, and run() resumes them in FIFO order
+ * until none is left.
+ */
+class EventLoop
+{
+    std::deque<std::coroutine_handle<>> ready_;
+
+public:
+    class schedule_awaiter
+    {
+        EventLoop *loop_;
+
+    public:
+        explicit schedule_awaiter(EventLoop *loop) noexcept : loop_{loop} {}
+
+        [[nodiscard]] auto await_ready() const noexcept -> bool
+        {
+            return false;
+        }
+
+        auto await_suspend(std::coroutine_handle<> self) -> void
+        {
+            loop_->post(self);
+        }
+
+        auto await_resume() const noexcept -> void {}
+    };
+
+    EventLoop() = default;
+    EventLoop(const EventLoop &) = delete;
+    auto operator=(const EventLoop &) -> EventLoop & = delete;
+
+    /**
+     * @brief Queue @p coroutine to be resumed by run()
+     */
+    auto post(std::coroutine_handle<> coroutine) -> void
+    {
+        ready_.push_back(coroutine);
+    }
+
+    /**
+     * @brief Awaitable that requeues the awaiting coroutine behind the
+     *        others
+     */
+    [[nodiscard]] auto schedule() noexcept -> schedule_awaiter
+    {
+        return schedule_awaiter{this};
+    }
+
+    /**
+     * @brief Queue @p task to start; it stays owned by the caller, who reads
+     *        its outcome once done() is true
+     */
+    template <typename T, typename E> auto spawn(Task<T, E> &task) -> void
+    {
+        post(task.handle_);
+    }
+
+    /**
+     * @brief Resume queued coroutines until the queue is empty
+     *
+     * @return The number of coroutines resumed
+     */
+    auto run() -> std::size_t
+    {
+        std::size_t resumed = 0;
+        while (!ready_.empty()) {
+            auto next = ready_.front();
+            ready_.pop_front();
+            next.resume();
+            ++resumed;
+        }
+        return resumed;
+    }
+
+    /**
+     * @brief Run @p task and everything it schedules to completion
+     *
+     * Panics if the queue drains while @p task is still suspended, e.g. on
+     * an awaitable that nothing resumes.
+     */
+    template <typename T, typename E>
+    auto block_on(Task<T, E> task) -> result::Result<T, E>
+    {
+        spawn(task);
+        run();
+        if (!task.done()) [[unlikely]] {
+            panic::__detail::begin_panic(
+                "EventLoop::block_on() ran out of work before the task "
+                "finished",
+                nullptr, nullptr);
+        }
+        return std::move(task).result();
+    }
+};
+
+} // namespace rstd
+
+template <typename T, typename E, typename Alloc, typename... Args>
+struct std::coroutine_traits<rstd::Task<T, E>, std::allocator_arg_t, Alloc,
+                             Args...>
+{
+    using promise_type = rstd::__detail::allocating_promise<
+        T, E, std::remove_cvref_t<Alloc>, std::remove_cvref_t<Args>...>;
+};
+
+template <typename T, typename E, typename Self, typename Alloc,
+          typename... Args>
+struct std::coroutine_traits<rstd::Task<T, E>, Self, std::allocator_arg_t,
+                             Alloc, Args...>
+{
+    using promise_type = rstd::__detail::allocating_method_promise<
+        T, E, std::remove_cvref_t<Self>, std::remove_cvref_t<Alloc>,
+        std::remove_cvref_t<Args>...>;
+};
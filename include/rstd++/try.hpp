@@ -0,0 +1,56 @@
+#pragma once
+
+#include <utility>
+
+#include "result.hpp"
+
+/**
+ * @file try.hpp
+ * @brief Early-return error propagation for Result, like Rust's `?`
+ *
+ * Both macros evaluate the Result once, test it once, and then either
+ * return its error from the enclosing function or move the Ok value out
+ * without any further check. The error is converted to the error type of
+ * the enclosing function's Result. An lvalue operand is copied from, never
+ * moved from.
+ */
+
+#define RSTD_TRY_CONCAT_IMPL(a, b) a##b
+#define RSTD_TRY_CONCAT(a, b) RSTD_TRY_CONCAT_IMPL(a, b)
+
+#define RSTD_TRY_ASSIGN_IMPL(lhs, expr, tmp)                                   \
+    auto &&tmp = (expr);                                                       \
+    if (tmp.is_err()) [[unlikely]] {                                           \
+        return ::rstd::result::__detail::try_access::propagate(                \
+            ::std::forward<decltype(tmp)>(tmp));                               \
+    }                                                                          \
+    lhs = ::rstd::result::__detail::try_access::take_value(                    \
+        ::std::forward<decltype(tmp)>(tmp))
+
+/**
+ * @brief Portable statement form: `RSTD_TRY_ASSIGN(auto v, parse(s));`
+ *
+ * @p lhs is either a declaration or an assignable expression.
+ */
+#define RSTD_TRY_ASSIGN(lhs, expr)                                             \
+    RSTD_TRY_ASSIGN_IMPL(                                                      \
+        lhs, expr, RSTD_TRY_CONCAT(rstd_try_result_, __COUNTER__))
+
+#if defined(__GNUC__) || defined(__clang__)
+/**
+ * @brief Expression form: `auto v = RSTD_TRY(parse(s)) + 1;`
+ *
+ * Built on GNU statement expressions; use RSTD_TRY_ASSIGN on compilers
+ * that lack them.
+ */
+#define RSTD_TRY(expr)                                                         \
+    __extension__({                                                            \
+        auto &&rstd_try_result_ = (expr);                                      \
+        if (rstd_try_result_.is_err()) [[unlikely]] {                          \
+            return ::rstd::result::__detail::try_access::propagate(            \
+                ::std::forward<decltype(rstd_try_result_)>(rstd_try_result_)); \
+        }                                                                      \
+        ::rstd::result::__detail::try_access::take_value(                      \
+            ::std::forward<decltype(rstd_try_result_)>(rstd_try_result_));     \
+    })
+#endif
@@ -0,0 +1,214 @@
+/**
+ * @file any_error_test.cpp
+ * @brief Unit tests for rstd::AnyError
+ */
+
+#include "rstd++/any_error.hpp"
+#include "rstd++/error.hpp"
+#include "rstd++/result.hpp"
+#include "rstd++/try.hpp"
+
+#include <array>
+#include <gtest/gtest.h>
+#include <memory>
+#include <sstream>
+#include <stdexcept>
+#include <string>
+#include <system_error>
+
+using namespace rstd;
+using namespace rstd::result;
+using std::string;
+
+namespace
+{
+
+struct ParseError
+{
+    int line;
+
+    friend auto operator<<(std::ostream &os, const ParseError &e)
+        -> std::ostream &
+    {
+        return os << "parse error at line " << e.line;
+    }
+};
+
+struct BigError
+{
+    std::array<int, 32> context{};
+    string what;
+
+    friend auto operator<<(std::ostream &os, const BigError &e)
+        -> std::ostream &
+    {
+        return os << "big: " << e.what;
+    }
+};
+
+struct Opaque
+{
+    int id;
+};
+
+/**
+ * @brief Error that counts its live instances
+ */
+struct Tracked
+{
+    static inline int live = 0;
+    std::shared_ptr<int> payload = std::make_shared<int>(7);
+
+    Tracked() { ++live; }
+    Tracked(const Tracked &other) : payload{other.payload} { ++live; }
+    Tracked(Tracked &&other) noexcept : payload{std::move(other.payload)}
+    {
+        ++live;
+    }
+    ~Tracked() { --live; }
+};
+
+auto parse(int line) -> Result<int, ParseError>
+{
+    if (line > 0) {
+        return rstd::Err(ParseError{line});
+    }
+    return rstd::Ok(42);
+}
+
+auto load(int line) -> Result<int, AnyError>
+{
+    auto value = RSTD_TRY(parse(line));
+    return rstd::Ok(value + 1);
+}
+
+auto to_string(const AnyError &e) -> string
+{
+    std::ostringstream os;
+    os << e;
+    return os.str();
+}
+
+} // namespace
+
+static_assert(AnyError::fits_inline<ParseError>);
+static_assert(AnyError::fits_inline<Error>);
+static_assert(AnyError::fits_inline<const char *>);
+static_assert(!AnyError::fits_inline<BigError>);
+
+// Error-like types convert implicitly, anything else only explicitly
+static_assert(std::is_convertible_v<ParseError, AnyError>);
+static_assert(std::is_convertible_v<Error, AnyError>);
+static_assert(std::is_convertible_v<std::errc, AnyError>);
+static_assert(std::is_convertible_v<std::runtime_error, AnyError>);
+static_assert(std::is_convertible_v<const char *, AnyError>);
+static_assert(std::is_convertible_v<string, AnyError>);
+static_assert(!std::is_convertible_v<int, AnyError>);
+static_assert(!std::is_convertible_v<Opaque, AnyError>);
+static_assert(!std::is_convertible_v<std::array<int, 2>, AnyError>);
+static_assert(std::is_constructible_v<AnyError, int>);
+static_assert(std::is_constructible_v<AnyError, Opaque>);
+// Recording error call sites adds a field to every Result
+#if !RSTD_ERROR_LOCATIONS
+static_assert(sizeof(Result<int, AnyError>) == sizeof(AnyError));
+static_assert(sizeof(Result<void, AnyError>) == sizeof(AnyError));
+#endif
+static_assert(std::is_nothrow_move_constructible_v<AnyError>);
+static_assert(is_cloneable<AnyError>);
+
+TEST(AnyErrorTest, DowncastInline)
+{
+    AnyError e = ParseError{3};
+    EXPECT_TRUE(e.is<ParseError>());
+    EXPECT_FALSE(e.is<BigError>());
+    ASSERT_NE(e.downcast_ref<ParseError>(), nullptr);
+    EXPECT_EQ(e.downcast_ref<ParseError>()->line, 3);
+    EXPECT_EQ(e.downcast_ref<Error>(), nullptr);
+
+    e.downcast_mut<ParseError>()->line = 5;
+    EXPECT_EQ(e.downcast_ref<ParseError>()->line, 5);
+}
+
+TEST(AnyErrorTest, DowncastHeap)
+{
+    AnyError e = BigError{{}, "overflow"};
+    ASSERT_NE(e.downcast_ref<BigError>(), nullptr);
+    EXPECT_EQ(e.downcast_ref<BigError>()->what, "overflow");
+
+    AnyError moved = std::move(e);
+    EXPECT_EQ(moved.downcast_ref<BigError>()->what, "overflow");
+    EXPECT_EQ(to_string(moved), "big: overflow");
+}
+
+TEST(AnyErrorTest, DowncastByValue)
+{
+    auto hit = AnyError(ParseError{9}).downcast<ParseError>();
+    ASSERT_TRUE(hit.is_ok());
+    EXPECT_EQ(hit.unwrap().line, 9);
+
+    auto miss = AnyError(Opaque{1}).downcast<ParseError>();
+    ASSERT_TRUE(miss.is_err());
+    EXPECT_EQ(miss.unwrap_err().downcast_ref<Opaque>()->id, 1);
+}
+
+TEST(AnyErrorTest, CopiesAreIndependent)
+{
+    AnyError a = string("first");
+    AnyError b = a;
+    *b.downcast_mut<string>() = "second";
+    EXPECT_EQ(*a.downcast_ref<string>(), "first");
+    EXPECT_EQ(*b.downcast_ref<string>(), "second");
+
+    AnyError big = BigError{{}, "one"};
+    AnyError big_copy = big;
+    big_copy.downcast_mut<BigError>()->what = "two";
+    EXPECT_EQ(big.downcast_ref<BigError>()->what, "one");
+
+    a = big;
+    EXPECT_TRUE(a.is<BigError>());
+    EXPECT_EQ(a.downcast_ref<BigError>()->what, "one");
+}
+
+TEST(AnyErrorTest, DestroysStoredError)
+{
+    {
+        AnyError e(Tracked{});
+        AnyError copy = e;
+        AnyError moved = std::move(e);
+        EXPECT_EQ(Tracked::live, 2);
+        copy = moved;
+        EXPECT_EQ(Tracked::live, 2);
+    }
+    EXPECT_EQ(Tracked::live, 0);
+}
+
+TEST(AnyErrorTest, Printing)
+{
+    EXPECT_EQ(to_string(ParseError{2}), "parse error at line 2");
+    EXPECT_EQ(to_string(AnyError(Opaque{1})), "<unprintable error>");
+    EXPECT_EQ(to_string(Error(std::make_error_code(std::errc::timed_out))),
+              to_string(Error(std::errc::timed_out)));
+}
+
+TEST(AnyErrorTest, ResultIntegration)
+{
+    EXPECT_EQ(load(0).unwrap(), 43);
+
+    auto failed = load(4);
+    ASSERT_TRUE(failed.is_err());
+    EXPECT_EQ(failed.unwrap_err().downcast_ref<ParseError>()->line, 4);
+
+    auto erased = parse(6).map_err([](ParseError e) { return AnyError(e); });
+    EXPECT_TRUE(erased.unwrap_err().is<ParseError>());
+
+    auto cloned = failed.clone();
+    EXPECT_EQ(cloned.unwrap_err().downcast_ref<ParseError>()->line, 4);
+
+    try {
+        (void)failed.unwrap();
+        FAIL() << "unwrap() should have panicked";
+    } catch (const std::runtime_error &e) {
+        EXPECT_STREQ(e.what(), "called `Result::unwrap()` on an `Err` value: "
+                               "parse error at line 4");
+    }
+}
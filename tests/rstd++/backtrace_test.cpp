@@ -0,0 +1,109 @@
+/**
+ * @file backtrace_test.cpp
+ * @brief Unit tests for sampled backtraces and Traced errors
+ */
+
+#include "rstd++/backtrace.hpp"
+#include "rstd++/result.hpp"
+#include "rstd++/try.hpp"
+
+#include <gtest/gtest.h>
+#include <sstream>
+#include <stdexcept>
+#include <string>
+
+using namespace rstd;
+using namespace rstd::result;
+using std::string;
+
+namespace
+{
+
+/**
+ * @brief Set a sample rate for the lifetime of a test
+ */
+class BacktraceTest : public ::testing::Test
+{
+protected:
+    unsigned saved_ = 0;
+
+    void SetUp() override { saved_ = Backtrace::set_sample_rate(1); }
+    void TearDown() override { Backtrace::set_sample_rate(saved_); }
+};
+
+[[gnu::noinline]] auto fail(int code) -> Result<int, Traced<int>>
+{
+    return rstd::Err(code);
+}
+
+auto relay(int code) -> Result<int, Traced<int>>
+{
+    auto v = RSTD_TRY(fail(code));
+    return rstd::Ok(v);
+}
+
+} // namespace
+
+TEST(BacktraceSamplingTest, DisabledByDefault)
+{
+    EXPECT_EQ(Backtrace::sample_rate(), 0u);
+    EXPECT_FALSE(Backtrace::capture_sampled().is_captured());
+
+    const Traced<int> e = 5;
+    EXPECT_FALSE(e.backtrace().is_captured());
+    EXPECT_TRUE(e.backtrace().addresses().empty());
+
+    std::ostringstream os;
+    os << e;
+    EXPECT_EQ(os.str(), "5");
+}
+
+TEST_F(BacktraceTest, CaptureRecordsFrames)
+{
+    const Backtrace bt = Backtrace::capture();
+    ASSERT_TRUE(bt.is_captured());
+    EXPECT_GT(bt.addresses().size(), 0u);
+    EXPECT_LE(bt.addresses().size(), Backtrace::max_frames);
+
+    const Backtrace copy = bt;
+    ASSERT_EQ(copy.addresses().size(), bt.addresses().size());
+    EXPECT_NE(copy.addresses().data(), bt.addresses().data());
+}
+
+TEST_F(BacktraceTest, SamplesOneInN)
+{
+    Backtrace::set_sample_rate(3);
+    int captured = 0;
+    for (int i = 0; i < 9; ++i) {
+        captured += Backtrace::capture_sampled().is_captured() ? 1 : 0;
+    }
+    EXPECT_EQ(captured, 3);
+}
+
+TEST_F(BacktraceTest, TracedErrorThroughResult)
+{
+    auto r = relay(7);
+    ASSERT_TRUE(r.is_err());
+    EXPECT_EQ(r.unwrap_err().error(), 7);
+    EXPECT_TRUE(r.unwrap_err().backtrace().is_captured());
+
+    // The backtrace does not take part in comparisons
+    EXPECT_EQ(r, relay(7));
+    EXPECT_NE(r, relay(8));
+}
+
+TEST_F(BacktraceTest, PrintedOnPanic)
+{
+    auto r = fail(3);
+    try {
+        (void)r.unwrap();
+        FAIL() << "unwrap() should have panicked";
+    } catch (const std::runtime_error &e) {
+        const string msg = e.what();
+        EXPECT_EQ(msg.rfind("called `Result::unwrap()` on an `Err` value: 3\n"
+                            "stack backtrace:\n  #0 ",
+                            0),
+                  0u)
+            << msg;
+    }
+}
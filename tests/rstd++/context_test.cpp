@@ -0,0 +1,147 @@
+/**
+ * @file context_test.cpp
+ * @brief Unit tests for error context chains
+ */
+
+#include "rstd++/context.hpp"
+#include "rstd++/result.hpp"
+#include "rstd++/try.hpp"
+
+#include <gtest/gtest.h>
+#include <sstream>
+#include <stdexcept>
+#include <string>
+
+using namespace rstd;
+using namespace rstd::result;
+using std::string;
+
+namespace
+{
+
+enum class ParseError
+{
+    Empty,
+    InvalidDigit,
+};
+
+auto operator<<(std::ostream &os, ParseError e) -> std::ostream &
+{
+    return os << (e == ParseError::Empty ? "empty input" : "invalid digit");
+}
+
+auto parse_number(const string &s) -> Result<int, ParseError>
+{
+    if (s.empty()) {
+        return rstd::Err(ParseError::Empty);
+    }
+    int value = 0;
+    for (char c : s) {
+        if (c < '0' || c > '9') {
+            return rstd::Err(ParseError::InvalidDigit);
+        }
+        value = value * 10 + (c - '0');
+    }
+    return rstd::Ok(value);
+}
+
+auto read_port(const string &line, int line_no)
+    -> Result<int, Context<ParseError>>
+{
+    auto port = RSTD_TRY(parse_number(line).context("reading line", line_no));
+    return rstd::Ok(port);
+}
+
+auto load_config(const string &line) -> Result<int, Context<ParseError>>
+{
+    return read_port(line, 12).context("loading config");
+}
+
+template <typename T> auto to_string(const T &value) -> string
+{
+    std::ostringstream os;
+    os << value;
+    return os.str();
+}
+
+} // namespace
+
+static_assert(
+    std::is_same_v<decltype(parse_number("").context("a").context("b")),
+                   Result<int, Context<ParseError>>>);
+static_assert(std::is_trivially_copyable_v<Context<ParseError>>);
+
+TEST(ContextTest, OkPassesThrough)
+{
+    auto r = load_config("8080");
+    ASSERT_TRUE(r.is_ok());
+    EXPECT_EQ(r.unwrap(), 8080);
+}
+
+TEST(ContextTest, FramesOutermostFirst)
+{
+    auto r = load_config("80x");
+    ASSERT_TRUE(r.is_err());
+
+    const auto &e = r.unwrap_err_unchecked();
+    EXPECT_EQ(e.error(), ParseError::InvalidDigit);
+    ASSERT_EQ(e.depth(), 2u);
+    EXPECT_STREQ(e.frames()[0].message(), "reading line");
+    EXPECT_TRUE(e.frames()[0].has_arg());
+    EXPECT_FALSE(e.frames()[1].has_arg());
+    EXPECT_EQ(to_string(e), "loading config: reading line 12: invalid digit");
+}
+
+TEST(ContextTest, ArgumentTypes)
+{
+    auto r = parse_number("")
+                 .context("in file", "ports.conf")
+                 .context("ratio", 0.5)
+                 .context("attempt", 'x');
+    EXPECT_EQ(to_string(r.unwrap_err()),
+              "attempt x: ratio 0.5: in file ports.conf: empty input");
+}
+
+TEST(ContextTest, OverflowIsCounted)
+{
+    auto r = parse_number("").context("0");
+    for (std::size_t i = 1; i < Context<ParseError>::capacity + 2; ++i) {
+        r.move_from(std::move(r).context("more"));
+    }
+    const auto &e = r.unwrap_err_unchecked();
+    EXPECT_EQ(e.depth(), Context<ParseError>::capacity + 2);
+    EXPECT_EQ(e.frames().size(), Context<ParseError>::capacity);
+    EXPECT_EQ(to_string(e).rfind("<2 more>: more: ", 0), 0u);
+}
+
+TEST(ContextTest, ComposesWithCombinators)
+{
+    auto mapped = load_config("").map_err(
+        [](const Context<ParseError> &e) { return to_string(e); });
+    EXPECT_EQ(mapped.unwrap_err(),
+              "loading config: reading line 12: empty input");
+
+    auto recovered = load_config("").or_else([](Context<ParseError> e) {
+        return e.error() == ParseError::Empty
+                   ? Result<int, Context<ParseError>>::Ok(80)
+                   : Result<int, Context<ParseError>>::Err(e);
+    });
+    EXPECT_EQ(recovered.unwrap(), 80);
+
+    auto failed = Result<void, ParseError>::Err(ParseError::Empty)
+                      .context("flushing");
+    EXPECT_EQ(failed.unwrap_err().depth(), 1u);
+    EXPECT_TRUE((Result<void, ParseError>::Ok().context("flushing").is_ok()));
+}
+
+TEST(ContextTest, PrintedOnPanic)
+{
+    try {
+        (void)load_config("x").unwrap();
+        FAIL() << "unwrap() should have panicked";
+    } catch (const std::runtime_error &e) {
+        EXPECT_STREQ(e.what(), "called `Result::unwrap()` on an `Err` value: "
+                               "loading config: reading line 12: "
+                               "invalid digit");
+    }
+}
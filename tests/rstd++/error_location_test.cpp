@@ -0,0 +1,95 @@
+/**
+ * @file error_location_test.cpp
+ * @brief Unit tests for Err call-site capture
+ *
+ * Built with RSTD_ERROR_LOCATIONS=1, independently of the error_locations
+ * option.
+ */
+
+#include "rstd++/result.hpp"
+#include "rstd++/result_coro.hpp"
+#include "rstd++/try.hpp"
+
+#include <gtest/gtest.h>
+#include <source_location>
+#include <string>
+
+using namespace rstd;
+using namespace rstd::result;
+using std::string;
+
+static_assert(RSTD_ERROR_LOCATIONS);
+
+namespace
+{
+
+std::uint_least32_t fail_line = 0;
+
+auto fail(bool failed) -> Result<int, string>
+{
+    if (failed) {
+        fail_line = std::source_location::current().line() + 1;
+        return Result<int, string>::Err("failed");
+    }
+    return Result<int, string>::Ok(1);
+}
+
+std::uint_least32_t deduced_line = 0;
+
+auto fail_deduced() -> Result<int, string>
+{
+    deduced_line = std::source_location::current().line() + 1;
+    return rstd::Err(string("deduced"));
+}
+
+auto relay() -> Result<long, string>
+{
+    auto v = RSTD_TRY(fail(true));
+    return rstd::Ok(long{v});
+}
+
+auto relay_coro() -> Result<int, string>
+{
+    int v = co_await fail(true);
+    co_return v;
+}
+
+} // namespace
+
+TEST(ErrorLocationTest, ErrCapturesCallSite)
+{
+    auto r = fail(true);
+    EXPECT_EQ(r.error_location().line(), fail_line);
+    EXPECT_EQ(string(r.error_location().file_name()),
+              std::source_location::current().file_name());
+
+    EXPECT_EQ(fail_deduced().error_location().line(), deduced_line);
+    EXPECT_EQ(fail(false).error_location().line(), 0u);
+}
+
+TEST(ErrorLocationTest, SiteSurvivesPropagation)
+{
+    EXPECT_EQ(relay().error_location().line(), fail_line);
+    EXPECT_EQ(relay_coro().error_location().line(), fail_line);
+
+    auto mapped = fail(true)
+                      .map([](int v) { return v * 2; })
+                      .map_err([](const string &e) { return e.size(); })
+                      .and_then([](int v) {
+                          return Result<int, std::size_t>::Ok(v);
+                      });
+    EXPECT_EQ(mapped.error_location().line(), fail_line);
+
+    auto copy = mapped.clone();
+    EXPECT_EQ(copy.error_location().line(), fail_line);
+    EXPECT_EQ(mapped.as_ref().error_location().line(), fail_line);
+}
+
+TEST(ErrorLocationTest, VoidResult)
+{
+    const auto line = std::source_location::current().line() + 1;
+    auto r = Result<void, int>::Err(3);
+    EXPECT_EQ(r.error_location().line(), line);
+    EXPECT_EQ(r.map_err([](int e) { return e + 1; }).error_location().line(),
+              line);
+}
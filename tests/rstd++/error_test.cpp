@@ -0,0 +1,142 @@
+/**
+ * @file error_test.cpp
+ * @brief Unit tests for rstd::Error
+ */
+
+#include "rstd++/error.hpp"
+#include "rstd++/result.hpp"
+#include "rstd++/try.hpp"
+
+#include <cerrno>
+#include <gtest/gtest.h>
+#include <sstream>
+#include <string>
+#include <system_error>
+
+using namespace rstd;
+using namespace rstd::result;
+
+namespace
+{
+
+enum class Shed : int
+{
+    QueueFull = 1,
+    DeadlineExceeded,
+};
+
+struct ShedCategory final : ErrorCategory
+{
+    auto name() const noexcept -> const char * override { return "shed"; }
+
+    auto describe(int code) const noexcept -> const char * override
+    {
+        switch (static_cast<Shed>(code)) {
+        case Shed::QueueFull:
+            return "queue full";
+        case Shed::DeadlineExceeded:
+            return "deadline exceeded";
+        }
+        return "unknown";
+    }
+};
+
+constinit const ShedCategory shed_category;
+
+constexpr auto shed(Shed reason) -> Error
+{
+    return Error(static_cast<int>(reason), shed_category);
+}
+
+auto admit(int depth) -> Result<int, Error>
+{
+    if (depth > 8) {
+        return rstd::Err(shed(Shed::QueueFull));
+    }
+    return rstd::Ok(depth);
+}
+
+auto open_config(bool exists) -> Result<int, Error>
+{
+    if (!exists) {
+        return rstd::Err(std::errc::no_such_file_or_directory);
+    }
+    return rstd::Ok(3);
+}
+
+auto admit_twice(int depth) -> Result<int, Error>
+{
+    auto first = RSTD_TRY(admit(depth));
+    auto second = RSTD_TRY(admit(depth * 2));
+    return rstd::Ok(first + second);
+}
+
+} // namespace
+
+static_assert(sizeof(Error) == 2 * sizeof(void *));
+// Recording error call sites adds a field to every Result
+#if !RSTD_ERROR_LOCATIONS
+static_assert(sizeof(Result<int, Error>) == sizeof(Error));
+static_assert(sizeof(Result<void, Error>) == sizeof(Error));
+#endif
+static_assert(std::is_trivially_copyable_v<Result<int, Error>>);
+
+// Creating an Error is a constant expression: no allocation is possible
+static_assert(shed(Shed::QueueFull).code() == 1);
+static_assert(shed(Shed::QueueFull) != shed(Shed::DeadlineExceeded));
+
+TEST(ErrorTest, CustomCategory)
+{
+    const Error e = shed(Shed::DeadlineExceeded);
+    EXPECT_EQ(e.code(), 2);
+    EXPECT_EQ(&e.category(), &shed_category);
+    EXPECT_EQ(e.message(), "deadline exceeded");
+
+    std::ostringstream os;
+    os << e;
+    EXPECT_EQ(os.str(), "shed:2 (deadline exceeded)");
+}
+
+TEST(ErrorTest, ResultRoundTrip)
+{
+    EXPECT_EQ(admit(3).unwrap(), 3);
+    EXPECT_EQ(admit(9).unwrap_err(), shed(Shed::QueueFull));
+    EXPECT_EQ(admit_twice(3).unwrap(), 9);
+    EXPECT_EQ(admit_twice(5).unwrap_err(), shed(Shed::QueueFull));
+}
+
+TEST(ErrorTest, StdErrorCodeInterop)
+{
+    const auto ec = std::make_error_code(std::errc::timed_out);
+    const Error e = ec;
+    EXPECT_EQ(e, ec);
+    EXPECT_EQ(e.to_error_code(), ec);
+
+    const std::error_code back = shed(Shed::QueueFull).to_error_code();
+    EXPECT_EQ(back.category().name(), std::string("shed"));
+    EXPECT_EQ(back.message(), "queue full");
+
+    auto r = open_config(false);
+    EXPECT_EQ(r.unwrap_err().to_error_code(),
+              std::errc::no_such_file_or_directory);
+}
+
+TEST(ErrorTest, Errno)
+{
+    const Error e = Error::from_errno(ENOENT);
+    EXPECT_EQ(e.to_error_code(), std::errc::no_such_file_or_directory);
+
+    errno = EACCES;
+    EXPECT_EQ(Error::last_errno(), Error::from_errno(EACCES));
+}
+
+TEST(ErrorTest, PanicMessageIsFormattedOnPrint)
+{
+    try {
+        (void)admit(100).unwrap();
+        FAIL() << "unwrap() should have panicked";
+    } catch (const std::runtime_error &e) {
+        EXPECT_STREQ(e.what(), "called `Result::unwrap()` on an `Err` value: "
+                               "shed:1 (queue full)");
+    }
+}
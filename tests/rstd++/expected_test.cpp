@@ -0,0 +1,106 @@
+/**
+ * @file expected_test.cpp
+ * @brief Unit tests for the std::expected interoperability of Result
+ *
+ * Built as C++23; the tests compile to nothing without std::expected.
+ */
+
+#include "rstd++/result.hpp"
+
+#include <gtest/gtest.h>
+#include <memory>
+#include <string>
+
+#if defined(__cpp_lib_expected)
+
+#include <expected>
+
+using namespace rstd::result;
+using std::string;
+
+namespace
+{
+
+auto parse_legacy(const string &s) -> Result<int, string>
+{
+    if (s.empty()) {
+        return rstd::Err("empty");
+    }
+    return rstd::Ok(std::stoi(s));
+}
+
+auto parse_modern(const string &s) -> std::expected<int, string>
+{
+    if (s.empty()) {
+        return std::unexpected("empty");
+    }
+    return std::stoi(s);
+}
+
+constexpr auto constexpr_round_trip(int v) -> int
+{
+    Result<int, int> r{std::expected<int, int>(v)};
+    return std::move(r).into_expected().value();
+}
+
+} // namespace
+
+static_assert(constexpr_round_trip(5) == 5);
+static_assert(std::is_convertible_v<std::expected<int, const char *>,
+                                    Result<long, string>>);
+static_assert(!std::is_convertible_v<std::expected<std::size_t, int>,
+                                     Result<std::vector<int>, int>>);
+static_assert(!std::is_constructible_v<Result<int, int>,
+                                       std::expected<int, int> &>);
+
+TEST(ExpectedInteropTest, IntoExpected)
+{
+    std::expected<int, string> ok = parse_legacy("12").into_expected();
+    EXPECT_EQ(ok.value(), 12);
+
+    std::expected<int, string> err = parse_legacy("").into_expected();
+    EXPECT_EQ(err.error(), "empty");
+}
+
+TEST(ExpectedInteropTest, FromExpected)
+{
+    Result<int, string> ok = parse_modern("7");
+    EXPECT_EQ(ok.unwrap(), 7);
+
+    Result<int, string> err = parse_modern("");
+    EXPECT_EQ(err.unwrap_err(), "empty");
+}
+
+TEST(ExpectedInteropTest, MoveOnlyPayloads)
+{
+    std::expected<std::unique_ptr<int>, string> ex = std::make_unique<int>(3);
+    Result<std::unique_ptr<int>, string> r = std::move(ex);
+    auto back = std::move(r).into_expected();
+    EXPECT_EQ(**back, 3);
+}
+
+TEST(ExpectedInteropTest, Comparison)
+{
+    const auto r = parse_legacy("4");
+    EXPECT_TRUE(r == parse_modern("4"));
+    EXPECT_FALSE(r == parse_modern("5"));
+    EXPECT_FALSE(r == parse_modern(""));
+    EXPECT_TRUE(parse_legacy("") == parse_modern(""));
+}
+
+TEST(ExpectedInteropTest, VoidResults)
+{
+    Result<void, string> ok = std::expected<void, string>();
+    EXPECT_TRUE(ok.is_ok());
+
+    Result<void, string> err =
+        std::expected<void, string>(std::unexpect, "failed");
+    EXPECT_EQ(err.error(), "failed");
+    const std::expected<void, string> expected_err(std::unexpect, "failed");
+    EXPECT_TRUE(err == expected_err);
+
+    auto back = std::move(err).into_expected();
+    EXPECT_EQ(back.error(), "failed");
+}
+
+#endif
@@ -0,0 +1,214 @@
+/**
+ * @file layout_test.cpp
+ * @brief Compile-time layout checks for a matrix of Result instantiations
+ *
+ * Each Case pins the size, alignment and special member properties of one
+ * Result<T, E>, so a layout regression in result.hpp breaks the build of
+ * this test. Running it prints how many bytes of each Result are padding.
+ *
+ * Built with RSTD_ERROR_LOCATIONS unset, since call-site capture adds a
+ * field to every Result.
+ */
+
+#include "rstd++/result.hpp"
+
+#include <algorithm>
+#include <cstddef>
+#include <cstdint>
+#include <cstdio>
+#include <gtest/gtest.h>
+#include <memory>
+#include <string>
+#include <tuple>
+#include <type_traits>
+
+using namespace rstd;
+using namespace rstd::result;
+
+static_assert(!RSTD_ERROR_LOCATIONS);
+
+namespace
+{
+
+enum class ErrEnum : std::int32_t
+{
+    NotFound = 1,
+};
+
+enum class SmallEnum : std::uint8_t
+{
+    Busy = 7,
+};
+
+namespace detail = rstd::result::__detail;
+
+using MoveOnly = std::unique_ptr<int>;
+
+// ==========================================================================
+// Expectations
+// ==========================================================================
+
+enum Props : unsigned
+{
+    trivial_copy = 1u << 0,
+    trivial_move = 1u << 1,
+    trivial_destroy = 1u << 2,
+    nothrow_move = 1u << 3,
+    standard_layout = 1u << 4,
+    niche = 1u << 5,
+};
+
+/**
+ * @brief Properties of a Result over trivially copyable T and E
+ */
+constexpr unsigned trivial = trivial_copy | trivial_move | trivial_destroy |
+                             nothrow_move | standard_layout;
+
+/**
+ * @brief Properties of a Result owning a resource: only its move is cheap
+ *
+ * Whether std::string and std::unique_ptr are standard-layout is up to the
+ * standard library, so the expectation follows it.
+ */
+constexpr unsigned owning =
+    nothrow_move | (std::is_standard_layout_v<std::string> &&
+                            std::is_standard_layout_v<MoveOnly>
+                        ? standard_layout
+                        : 0u);
+
+/**
+ * @brief Size of a tagged layout: the larger payload and a one-byte
+ *        discriminant, rounded up to the alignment
+ */
+constexpr auto tagged(std::size_t payload, std::size_t align) -> std::size_t
+{
+    return (payload + 1 + align - 1) / align * align;
+}
+
+struct Expect
+{
+    std::size_t size;
+    std::size_t align;
+    unsigned props;
+};
+
+template <typename T> constexpr const char *name = nullptr;
+template <> constexpr const char *name<void> = "void";
+template <> constexpr const char *name<Void> = "Void";
+template <> constexpr const char *name<char> = "char";
+template <> constexpr const char *name<int> = "int";
+template <> constexpr const char *name<double> = "double";
+template <> constexpr const char *name<std::uint64_t> = "uint64_t";
+template <> constexpr const char *name<int *> = "int *";
+template <> constexpr const char *name<int &> = "int &";
+template <> constexpr const char *name<ErrEnum> = "ErrEnum";
+template <> constexpr const char *name<SmallEnum> = "SmallEnum";
+template <> constexpr const char *name<std::string> = "string";
+template <> constexpr const char *name<MoveOnly> = "unique_ptr<int>";
+
+/**
+ * @brief Layout checks and report row for Result<T, E>
+ */
+template <typename T, typename E, Expect X> struct Case
+{
+    using R = Result<T, E>;
+    using U = detail::value_or_unit_t<T>;
+    using V = detail::stored_t<U>;
+    using F = detail::stored_t<E>;
+
+    static constexpr bool packed = detail::niche_layout<V, F>::enabled;
+
+    static constexpr auto has(unsigned prop) -> bool
+    {
+        return (X.props & prop) != 0;
+    }
+
+    static_assert(sizeof(R) == X.size, "sizeof(Result) changed");
+    static_assert(alignof(R) == X.align, "alignof(Result) changed");
+    static_assert(packed == has(niche), "niche packing changed");
+    static_assert(std::is_trivially_copy_constructible_v<R> ==
+                      has(trivial_copy),
+                  "trivial copy changed");
+    static_assert(std::is_trivially_move_constructible_v<R> ==
+                      has(trivial_move),
+                  "trivial move changed");
+    static_assert(std::is_trivially_destructible_v<R> == has(trivial_destroy),
+                  "trivial destruction changed");
+    static_assert(std::is_trivially_copyable_v<R> ==
+                      (has(trivial_copy) && has(trivial_move) &&
+                       has(trivial_destroy)),
+                  "trivial copyability changed");
+    static_assert(std::is_nothrow_move_constructible_v<R> ==
+                      has(nothrow_move),
+                  "nothrow move changed");
+    static_assert(std::is_standard_layout_v<R> == has(standard_layout),
+                  "standard layout changed");
+
+    static constexpr std::size_t payload = std::max(sizeof(V), sizeof(F));
+    static constexpr std::size_t discriminant = packed ? 0 : 1;
+    static constexpr std::size_t padding = sizeof(R) - payload - discriminant;
+
+    static auto report() -> void
+    {
+        std::printf("%-34s %5zu %6zu %8zu %4zu %8zu\n",
+                    (std::string("Result<") + name<T> + ", " + name<E> + ">")
+                        .c_str(),
+                    sizeof(R), alignof(R), payload, discriminant, padding);
+    }
+};
+
+constexpr std::size_t ptr = sizeof(void *);
+constexpr std::size_t str = sizeof(std::string);
+constexpr std::size_t str_align = alignof(std::string);
+
+// ==========================================================================
+// Matrix
+// ==========================================================================
+
+using Matrix = std::tuple<
+    // Scalars and enums: payload plus a tag
+    Case<int, ErrEnum, Expect{tagged(4, 4), 4, trivial}>,
+    Case<int, SmallEnum, Expect{tagged(4, 4), 4, trivial}>,
+    Case<char, SmallEnum, Expect{2, 1, trivial}>,
+    Case<double, ErrEnum, Expect{tagged(8, 8), 8, trivial}>,
+    Case<std::uint64_t, std::uint64_t, Expect{tagged(8, 8), 8, trivial}>,
+    Case<ErrEnum, SmallEnum, Expect{tagged(4, 4), 4, trivial}>,
+
+    // void is stored as the empty Void
+    Case<void, ErrEnum, Expect{tagged(4, 4), 4, trivial}>,
+    Case<void, SmallEnum, Expect{2, 1, trivial}>,
+    Case<void, Void, Expect{2, 1, trivial}>,
+    Case<void, std::string, Expect{tagged(str, str_align), str_align, owning}>,
+
+    // Pointers and references carry a niche for the error
+    Case<int *, ErrEnum, Expect{ptr, ptr, trivial | niche}>,
+    Case<int *, Void, Expect{ptr, ptr, trivial | niche}>,
+    Case<int &, ErrEnum, Expect{ptr, ptr, trivial | niche}>,
+
+    // Strings
+    Case<std::string, ErrEnum,
+         Expect{tagged(str, str_align), str_align, owning}>,
+    Case<std::string, std::string,
+         Expect{tagged(str, str_align), str_align, owning}>,
+
+    // Move-only types
+    Case<MoveOnly, ErrEnum, Expect{ptr, ptr, owning | niche}>,
+    Case<int, MoveOnly, Expect{ptr, ptr, owning | niche}>,
+    Case<MoveOnly, std::string,
+         Expect{tagged(str, str_align), str_align, owning}>>;
+
+template <typename... Cases> auto report(std::tuple<Cases...> *) -> void
+{
+    std::printf("%-34s %5s %6s %8s %4s %8s\n", "instantiation", "size",
+                "align", "payload", "tag", "padding");
+    (Cases::report(), ...);
+}
+
+} // namespace
+
+TEST(LayoutTest, Report)
+{
+    // Instantiating the report runs the checks of every Case
+    report(static_cast<Matrix *>(nullptr));
+    SUCCEED();
+}
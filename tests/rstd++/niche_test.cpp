@@ -0,0 +1,208 @@
+/**
+ * @file niche_test.cpp
+ * @brief Unit tests for niche-packed Result layouts
+ */
+
+#include "rstd++/niche.hpp"
+#include "rstd++/result.hpp"
+
+#include <cstdint>
+#include <gtest/gtest.h>
+#include <memory>
+#include <ostream>
+#include <string>
+
+using namespace rstd;
+using namespace rstd::result;
+
+#define take(a) std::move(a)
+
+namespace
+{
+
+enum class ErrEnum : std::int32_t
+{
+    NotFound = 1,
+    Denied,
+};
+
+enum class SmallEnum : std::uint8_t
+{
+    Busy = 7,
+};
+
+struct Handle
+{
+    static constexpr std::uint32_t invalid_id = ~std::uint32_t{0};
+
+    std::uint32_t id;
+    std::uint16_t generation;
+};
+
+auto operator<<(std::ostream &os, ErrEnum e) -> std::ostream &
+{
+    return os << "ErrEnum(" << static_cast<std::int32_t>(e) << ")";
+}
+
+auto operator<<(std::ostream &os, SmallEnum e) -> std::ostream &
+{
+    return os << "SmallEnum(" << static_cast<int>(e) << ")";
+}
+
+auto operator<<(std::ostream &os, const Handle &h) -> std::ostream &
+{
+    return os << "Handle(" << h.id << ", " << h.generation << ")";
+}
+
+} // namespace
+
+template <>
+struct rstd::niche_traits<Handle>
+    : rstd::sentinel_niche<Handle, Handle::invalid_id, 0>
+{};
+
+// Declared here, defined at the end of the file: the pointer niche must
+// not change once they are complete
+struct Opaque;
+struct Aligned;
+
+template <>
+struct rstd::pointee_alignment<Aligned>
+    : std::integral_constant<std::size_t, 8>
+{};
+
+static_assert(!niche_traits<Opaque *>::has_niche);
+static_assert(!niche_traits<std::unique_ptr<Opaque>>::has_niche);
+static_assert(niche_traits<Aligned *>::has_niche);
+static_assert(niche_traits<const Aligned *>::has_niche);
+
+// Recording error call sites adds a field to every Result
+#if !RSTD_ERROR_LOCATIONS
+static_assert(sizeof(Result<int *, ErrEnum>) == sizeof(int *));
+static_assert(sizeof(Result<const double *, SmallEnum>) == sizeof(double *));
+static_assert(sizeof(Result<std::unique_ptr<int>, ErrEnum>) == sizeof(int *));
+static_assert(sizeof(Result<Handle, SmallEnum>) == sizeof(Handle));
+static_assert(sizeof(Result<int *, Void>) == sizeof(int *));
+static_assert(std::is_trivially_copyable_v<Result<int *, ErrEnum>>);
+
+// Without a niche in T, the niche of E marks the Ok state instead
+static_assert(sizeof(Result<ErrEnum, std::unique_ptr<int>>) == sizeof(int *));
+static_assert(sizeof(Result<SmallEnum, Handle>) == sizeof(Handle));
+
+// No spare bits, or an error too large for the payload: fall back to a tag
+static_assert(sizeof(Result<char *, ErrEnum>) > sizeof(char *));
+static_assert(sizeof(Result<int *, const char *>) > sizeof(int *));
+static_assert(sizeof(Result<Handle, std::uint64_t>) > sizeof(Handle));
+#endif
+
+TEST(ResultNicheTest, PointerOkAndErr)
+{
+    int value = 42;
+    auto r1 = Result<int *, ErrEnum>::Ok(&value);
+    EXPECT_TRUE(r1.is_ok());
+    EXPECT_EQ(*r1.unwrap(), 42);
+
+    auto r2 = Result<int *, ErrEnum>::Ok(nullptr);
+    EXPECT_TRUE(r2.is_ok());
+    EXPECT_EQ(r2.unwrap(), nullptr);
+
+    auto r3 = Result<int *, ErrEnum>::Err(ErrEnum::Denied);
+    EXPECT_TRUE(r3.is_err());
+    EXPECT_EQ(r3.unwrap_err(), ErrEnum::Denied);
+}
+
+TEST(ResultNicheTest, PointerStateChanges)
+{
+    int value = 1;
+    auto r1 = Result<int *, ErrEnum>::Err(ErrEnum::NotFound);
+    const auto r2 = Result<int *, ErrEnum>::Ok(&value);
+    const auto r3 = Result<int *, ErrEnum>::Err(ErrEnum::Denied);
+
+    r1.clone_from(r2);
+    EXPECT_TRUE(r1.is_ok());
+    EXPECT_EQ(r1.unwrap(), &value);
+
+    r1.clone_from(r3);
+    EXPECT_TRUE(r1.is_err());
+    EXPECT_EQ(r1.unwrap_err(), ErrEnum::Denied);
+}
+
+TEST(ResultNicheTest, UniquePtrOwnership)
+{
+    auto r1 = Result<std::unique_ptr<int>, ErrEnum>::Ok(
+        std::make_unique<int>(69));
+    EXPECT_TRUE(r1.is_ok());
+
+    auto r2 = Result<std::unique_ptr<int>, ErrEnum>::Err(ErrEnum::NotFound);
+    EXPECT_TRUE(r2.is_err());
+    EXPECT_EQ(r2.unwrap_err(), ErrEnum::NotFound);
+
+    r2.move_from(take(r1));
+    EXPECT_TRUE(r2.is_ok());
+    EXPECT_EQ(*take(r2).unwrap(), 69);
+
+    auto r3 = Result<std::unique_ptr<int>, ErrEnum>::Ok(nullptr);
+    EXPECT_TRUE(r3.is_ok());
+    EXPECT_EQ(take(r3).unwrap(), nullptr);
+}
+
+TEST(ResultNicheTest, NicheInError)
+{
+    auto r1 = Result<ErrEnum, std::unique_ptr<int>>::Ok(ErrEnum::Denied);
+    EXPECT_TRUE(r1.is_ok());
+    EXPECT_EQ(r1.unwrap(), ErrEnum::Denied);
+
+    auto r2 = Result<ErrEnum, std::unique_ptr<int>>::Err(nullptr);
+    EXPECT_TRUE(r2.is_err());
+    EXPECT_EQ(take(r2).unwrap_err(), nullptr);
+
+    r1.move_from(Result<ErrEnum, std::unique_ptr<int>>::Err(
+        std::make_unique<int>(3)));
+    EXPECT_TRUE(r1.is_err());
+    EXPECT_EQ(*take(r1).unwrap_err(), 3);
+}
+
+TEST(ResultNicheTest, SentinelHandle)
+{
+    auto r1 = Result<Handle, SmallEnum>::Ok(Handle{7, 3});
+    EXPECT_TRUE(r1.is_ok());
+    EXPECT_EQ(r1.unwrap().id, 7u);
+    EXPECT_EQ(r1.unwrap().generation, 3u);
+
+    auto r2 = Result<Handle, SmallEnum>::Err(SmallEnum::Busy);
+    EXPECT_TRUE(r2.is_err());
+    EXPECT_EQ(r2.unwrap_err(), SmallEnum::Busy);
+    EXPECT_EQ(r1.map([](const Handle &h) -> int { return h.generation; })
+                  .unwrap(),
+              3);
+}
+
+TEST(ResultNicheTest, OptInClassPointer)
+{
+    Aligned *none = nullptr;
+    auto r1 = Result<Aligned *, ErrEnum>::Ok(none);
+    EXPECT_TRUE(r1.is_ok());
+    EXPECT_EQ(r1.unwrap(), nullptr);
+
+    auto r2 = Result<Aligned *, ErrEnum>::Err(ErrEnum::Denied);
+    EXPECT_TRUE(r2.is_err());
+    EXPECT_EQ(r2.unwrap_err(), ErrEnum::Denied);
+}
+
+struct Opaque
+{
+    std::uint64_t word;
+};
+
+struct alignas(8) Aligned
+{
+    std::uint64_t word;
+};
+
+// Completing the types leaves the layouts as they were above
+static_assert(!niche_traits<Opaque *>::has_niche);
+static_assert(niche_traits<Aligned *>::has_niche);
+#if !RSTD_ERROR_LOCATIONS
+static_assert(sizeof(Result<Opaque *, ErrEnum>) > sizeof(Opaque *));
+static_assert(sizeof(Result<Aligned *, ErrEnum>) == sizeof(Aligned *));
+#endif
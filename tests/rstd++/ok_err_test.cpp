@@ -0,0 +1,137 @@
+/**
+ * @file ok_err_test.cpp
+ * @brief Unit tests for the deduced Ok(value) and Err(error) wrappers
+ */
+
+#include "rstd++/result.hpp"
+#include "rstd++/result_coro.hpp"
+
+#include <gtest/gtest.h>
+#include <memory>
+#include <string>
+#include <vector>
+
+using std::string;
+
+namespace
+{
+
+auto divide(int a, int b) -> rstd::result::Result<int, const char *>
+{
+    if (b == 0) {
+        return rstd::Err("Division by zero");
+    }
+    return rstd::Ok(a / b);
+}
+
+auto describe(int code) -> rstd::result::Result<string, string>
+{
+    if (code < 0) {
+        return rstd::Err("negative code");
+    }
+    return rstd::Ok("code " + std::to_string(code));
+}
+
+auto make_box(bool ok) -> rstd::result::Result<std::unique_ptr<int>, string>
+{
+    if (!ok) {
+        return rstd::Err(string("no box"));
+    }
+    return rstd::Ok(std::make_unique<int>(8));
+}
+
+auto check(bool ok) -> rstd::result::Result<void, string>
+{
+    if (!ok) {
+        return rstd::Err("check failed");
+    }
+    return rstd::Ok();
+}
+
+auto halve_even(int v) -> rstd::result::Result<int, string>
+{
+    if (v % 2 != 0) {
+        co_return rstd::Err("odd");
+    }
+    co_return v / 2;
+}
+
+constexpr auto constexpr_divide(int a, int b)
+    -> rstd::result::Result<int, int>
+{
+    if (b == 0) {
+        return rstd::Err(-1);
+    }
+    return rstd::Ok(a / b);
+}
+
+} // namespace
+
+static_assert(constexpr_divide(8, 2).unwrap() == 4);
+static_assert(constexpr_divide(8, 0).unwrap_err() == -1);
+static_assert(std::is_same_v<decltype(rstd::Ok("text")),
+                             rstd::OkValue<const char *>>);
+
+// Conversions follow the payload: explicit payload constructors stay
+// explicit
+static_assert(std::is_convertible_v<rstd::OkValue<const char *>,
+                                    rstd::result::Result<string, int>>);
+static_assert(!std::is_convertible_v<rstd::OkValue<std::size_t>,
+                                     rstd::result::Result<std::vector<int>,
+                                                          int>>);
+static_assert(std::is_constructible_v<rstd::result::Result<std::vector<int>,
+                                                           int>,
+                                      rstd::OkValue<std::size_t>>);
+static_assert(!std::is_constructible_v<rstd::result::Result<int, int>,
+                                       rstd::ErrValue<string>>);
+
+TEST(OkErrTest, DeducedFactories)
+{
+    EXPECT_EQ(divide(9, 3).unwrap(), 3);
+    EXPECT_STREQ(divide(9, 0).unwrap_err(), "Division by zero");
+
+    EXPECT_EQ(describe(4).unwrap(), "code 4");
+    EXPECT_EQ(describe(-4).unwrap_err(), "negative code");
+}
+
+TEST(OkErrTest, MoveOnlyPayloads)
+{
+    EXPECT_EQ(*make_box(true).unwrap(), 8);
+    EXPECT_EQ(make_box(false).unwrap_err(), "no box");
+}
+
+TEST(OkErrTest, VoidResults)
+{
+    EXPECT_TRUE(check(true).is_ok());
+    EXPECT_EQ(check(false).unwrap_err(), "check failed");
+}
+
+TEST(OkErrTest, ExplicitConversion)
+{
+    const rstd::result::Result<std::vector<int>, int> r{rstd::Ok(3u)};
+    EXPECT_EQ(r.value().size(), 3u);
+
+    const auto wrapped = rstd::Err(string("kept"));
+    const rstd::result::Result<int, string> copied = wrapped;
+    EXPECT_EQ(copied.error(), "kept");
+    EXPECT_EQ(wrapped.error, "kept");
+}
+
+TEST(OkErrTest, Comparison)
+{
+    const auto ok = divide(8, 2);
+    const auto err = divide(8, 0);
+
+    EXPECT_TRUE(ok == rstd::Ok(4));
+    EXPECT_TRUE(ok != rstd::Ok(5));
+    EXPECT_TRUE(ok != rstd::Err("Division by zero"));
+    EXPECT_TRUE(rstd::Ok(4) == ok);
+    EXPECT_TRUE(err == rstd::Err(err.error()));
+    EXPECT_TRUE(check(true) == rstd::Ok());
+}
+
+TEST(OkErrTest, CoroutineReturn)
+{
+    EXPECT_EQ(halve_even(8).unwrap(), 4);
+    EXPECT_EQ(halve_even(7).unwrap_err(), "odd");
+}
@@ -0,0 +1,229 @@
+/**
+ * @file option_test.cpp
+ * @brief Unit tests for Option, NonZero and their Result conversions
+ */
+
+#include "rstd++/option.hpp"
+#include "rstd++/result.hpp"
+
+#include <cstdint>
+#include <gtest/gtest.h>
+#include <memory>
+#include <optional>
+#include <string>
+#include <vector>
+
+using namespace rstd;
+using namespace rstd::result;
+using std::string;
+
+namespace
+{
+
+enum class Slot : std::uint8_t
+{
+    A,
+    B,
+    Empty = 0xff,
+};
+
+} // namespace
+
+template <>
+struct rstd::niche_traits<Slot> : rstd::sentinel_niche<Slot, Slot::Empty>
+{};
+
+namespace
+{
+
+auto operator<<(std::ostream &os, Slot s) -> std::ostream &
+{
+    return os << static_cast<int>(s);
+}
+
+constexpr auto half(int v) -> Option<int>
+{
+    return v % 2 == 0 ? Option<int>::Some(v / 2) : Option<int>::None();
+}
+
+} // namespace
+
+// ======================================================================
+// Layout
+// ======================================================================
+
+static_assert(sizeof(Option<NonZero<std::uint32_t>>) == 4);
+static_assert(sizeof(Option<NonZero<std::uint64_t>>) == 8);
+static_assert(sizeof(Option<int &>) == sizeof(int *));
+static_assert(sizeof(Option<const string &>) == sizeof(void *));
+static_assert(sizeof(Option<long *>) == sizeof(long *));
+static_assert(sizeof(Option<std::unique_ptr<int>>) == sizeof(int *));
+static_assert(sizeof(Option<Slot>) == 1);
+static_assert(sizeof(Option<std::uint32_t>) == 8);
+
+static_assert(std::is_trivially_copyable_v<Option<int>>);
+static_assert(std::is_trivially_copyable_v<Option<NonZero<std::uint32_t>>>);
+static_assert(std::is_trivially_copyable_v<Option<int &>>);
+static_assert(!std::is_copy_constructible_v<Option<std::unique_ptr<int>>>);
+static_assert(std::is_nothrow_move_constructible_v<Option<string>>);
+
+// Without a niche Option works in constant expressions
+static_assert(Option<int>::Some(3).map([](int v) { return v * 2; }) == 6);
+static_assert(half(3).unwrap_or(-1) == -1);
+static_assert(NonZero<int>(5).get() == 5);
+
+TEST(OptionTest, SomeAndNone)
+{
+    auto some = Option<string>::Some("abc");
+    EXPECT_TRUE(some.is_some());
+    EXPECT_EQ(some.unwrap(), "abc");
+    EXPECT_EQ(*some, "abc");
+    EXPECT_EQ(some->size(), 3u);
+
+    Option<string> empty = none;
+    EXPECT_TRUE(empty.is_none());
+    EXPECT_FALSE(empty);
+    EXPECT_EQ(empty, none);
+    EXPECT_EQ(empty.unwrap_or("def"), "def");
+    EXPECT_EQ(empty.unwrap_or_default(), "");
+    EXPECT_EQ(Some(42), Option<int>::Some(42));
+    EXPECT_NE(Some(42), Option<int>());
+}
+
+TEST(OptionTest, NicheTypes)
+{
+    auto n = NonZero<std::uint32_t>::make(7);
+    ASSERT_TRUE(n.is_some());
+    EXPECT_EQ(n.unwrap().get(), 7u);
+    EXPECT_TRUE(NonZero<std::uint32_t>::make(0).is_none());
+
+    std::vector<Option<NonZero<std::uint32_t>>> index(4);
+    index[2] = NonZero<std::uint32_t>::make(9);
+    EXPECT_TRUE(index[0].is_none());
+    EXPECT_EQ(index[2].unwrap(), NonZero<std::uint32_t>(9));
+    index[2].reset();
+    EXPECT_TRUE(index[2].is_none());
+
+    auto slot = Option<Slot>::Some(Slot::B);
+    EXPECT_EQ(slot, Slot::B);
+    EXPECT_TRUE(Option<Slot>().is_none());
+
+    long value = 4;
+    auto ptr = Option<long *>::Some(nullptr);
+    EXPECT_TRUE(ptr.is_some());
+    ptr.emplace(&value);
+    EXPECT_EQ(*ptr.unwrap(), 4);
+    EXPECT_TRUE(Option<long *>().is_none());
+}
+
+TEST(OptionTest, References)
+{
+    int value = 1;
+    auto ref = Option<int &>::Some(value);
+    ref.unwrap() = 5;
+    EXPECT_EQ(value, 5);
+    EXPECT_EQ(&ref.unwrap_unchecked(), &value);
+
+    auto copy = ref.map([](int v) { return v + 1; });
+    static_assert(std::is_same_v<decltype(copy), Option<int>>);
+    EXPECT_EQ(copy, 6);
+    EXPECT_TRUE(Option<int &>().is_none());
+}
+
+TEST(OptionTest, Combinators)
+{
+    EXPECT_EQ(half(8).and_then(half), 2);
+    EXPECT_TRUE(half(6).and_then(half).is_none());
+    EXPECT_EQ(half(8).filter([](int v) { return v > 3; }), 4);
+    EXPECT_TRUE(half(6).filter([](int v) { return v > 3; }).is_none());
+    EXPECT_EQ(half(3).or_(Some(9)), 9);
+    EXPECT_EQ(half(3).or_else([] { return Some(1); }), 1);
+    EXPECT_EQ(half(4).map_or(0, [](int v) { return v * 10; }), 20);
+    EXPECT_TRUE(half(4).is_some_and([](int v) { return v == 2; }));
+
+    auto box = Option<std::unique_ptr<int>>::Some(std::make_unique<int>(3));
+    auto taken = box.take();
+    EXPECT_TRUE(box.is_none());
+    EXPECT_EQ(*std::move(taken).unwrap(), 3);
+}
+
+TEST(OptionTest, ToResult)
+{
+    auto ok = half(4).ok_or(string("odd"));
+    static_assert(std::is_same_v<decltype(ok), Result<int, string>>);
+    EXPECT_EQ(ok.unwrap(), 2);
+    EXPECT_EQ(half(5).ok_or(string("odd")).unwrap_err(), "odd");
+
+    int calls = 0;
+    auto lazy = [&calls] {
+        ++calls;
+        return string("odd");
+    };
+    EXPECT_EQ(half(4).ok_or_else(lazy).unwrap(), 2);
+    EXPECT_EQ(calls, 0);
+    EXPECT_EQ(half(5).ok_or_else(lazy).unwrap_err(), "odd");
+    EXPECT_EQ(calls, 1);
+}
+
+TEST(OptionTest, Transpose)
+{
+    using Nested = Option<Result<int, string>>;
+    using Flat = Result<Option<int>, string>;
+
+    auto some_ok = Flat::Ok(Some(4)).transpose();
+    static_assert(std::is_same_v<decltype(some_ok), Nested>);
+    ASSERT_TRUE(some_ok.is_some());
+    EXPECT_EQ(some_ok.unwrap_unchecked().unwrap(), 4);
+
+    auto some_err = Flat::Err("bad").transpose();
+    EXPECT_EQ(some_err.unwrap_unchecked().unwrap_err(), "bad");
+    EXPECT_TRUE(Flat::Ok(none).transpose().is_none());
+
+    // And back again: Option<Result> -> Result<Option>
+    auto round_trip = std::move(some_ok).transpose();
+    static_assert(std::is_same_v<decltype(round_trip), Flat>);
+    EXPECT_EQ(round_trip.unwrap(), 4);
+    EXPECT_EQ(std::move(some_err).transpose().unwrap_err(), "bad");
+    EXPECT_TRUE(Nested().transpose().unwrap().is_none());
+}
+
+TEST(OptionTest, ResultAdaptersMoveOut)
+{
+    auto r = Result<std::unique_ptr<int>, string>::Ok(std::make_unique<int>(8));
+    auto ok = std::move(r).ok();
+    static_assert(std::is_same_v<decltype(ok), Option<std::unique_ptr<int>>>);
+    EXPECT_EQ(*ok.unwrap_unchecked(), 8);
+
+    int value = 2;
+    auto ref = Result<int &, string>::Ok(value);
+    static_assert(std::is_same_v<decltype(ref.ok()), Option<int &>>);
+    EXPECT_EQ(&ref.ok().unwrap_unchecked(), &value);
+
+    auto failed = Result<void, string>::Err("gone");
+    EXPECT_EQ(failed.err(), string("gone"));
+}
+
+TEST(OptionTest, StdOptionCallersCompile)
+{
+    auto r = Result<int, string>::Ok(3);
+    auto failed = Result<int, string>::Err("bad");
+    EXPECT_EQ(r.ok().value_or(0), 3);
+    EXPECT_EQ(failed.ok().value_or(0), 0);
+    EXPECT_EQ(failed.err().value_or("none"), "bad");
+
+    std::optional<int> o = r.ok();
+    EXPECT_EQ(o, 3);
+    std::optional<int> empty = failed.ok();
+    EXPECT_FALSE(empty.has_value());
+
+    EXPECT_TRUE(failed.ok() == std::nullopt);
+    EXPECT_TRUE(std::nullopt == failed.ok());
+    EXPECT_TRUE(r.ok() != std::nullopt);
+
+    auto boxed = Result<std::unique_ptr<int>, string>::Ok(
+        std::make_unique<int>(5));
+    std::optional<std::unique_ptr<int>> moved = std::move(boxed).ok();
+    EXPECT_EQ(**moved, 5);
+    static_assert(!std::is_convertible_v<const Option<std::unique_ptr<int>> &,
+                                         std::optional<std::unique_ptr<int>>>);
+}
@@ -0,0 +1,109 @@
+/**
+ * @file panic_test.cpp
+ * @brief Unit tests for the panic hook used by Result
+ */
+
+#include "rstd++/panic.hpp"
+#include "rstd++/result.hpp"
+
+#include <gtest/gtest.h>
+#include <stdexcept>
+#include <string>
+
+using namespace rstd;
+using namespace rstd::result;
+using std::string;
+
+namespace
+{
+
+struct Captured
+{
+    string message;
+    std::size_t length;
+    bool truncated;
+};
+
+Captured last_panic;
+
+struct HookCalled
+{};
+
+void capture_hook(const panic::PanicInfo &info)
+{
+    last_panic = {info.message, info.length, info.truncated};
+    throw HookCalled{};
+}
+
+/**
+ * @brief Install capture_hook for the lifetime of a test
+ */
+class PanicHookTest : public ::testing::Test
+{
+protected:
+    void SetUp() override { panic::set_hook(&capture_hook); }
+    void TearDown() override { panic::take_hook(); }
+};
+
+} // namespace
+
+TEST(PanicDefaultHookTest, ThrowsRuntimeError)
+{
+    auto r1 = Result<int, string>::Err("boom");
+    try {
+        r1.unwrap();
+        FAIL() << "unwrap() on an Err must panic";
+    } catch (const std::runtime_error &e) {
+        EXPECT_STREQ(e.what(),
+                     "called `Result::unwrap()` on an `Err` value: boom");
+    }
+}
+
+TEST_F(PanicHookTest, HookReceivesFormattedMessage)
+{
+    auto r1 = Result<int, string>::Err("boom");
+    EXPECT_THROW(r1.expect("loading config"), HookCalled);
+    EXPECT_EQ(last_panic.message, "loading config: boom");
+    EXPECT_EQ(last_panic.length, last_panic.message.size());
+    EXPECT_FALSE(last_panic.truncated);
+
+    auto r2 = Result<int, string>::Ok(7);
+    EXPECT_THROW(r2.unwrap_err(), HookCalled);
+    EXPECT_EQ(last_panic.message,
+              "called `Result::unwrap_err()` on an `Ok` value: 7");
+}
+
+TEST_F(PanicHookTest, LongMessageIsTruncated)
+{
+    auto r1 = Result<int, string>::Err(string(4 * panic::message_capacity,
+                                              'x'));
+    EXPECT_THROW(r1.unwrap(), HookCalled);
+    EXPECT_TRUE(last_panic.truncated);
+    EXPECT_EQ(last_panic.length, panic::message_capacity - 1);
+    EXPECT_EQ(last_panic.message.size(), panic::message_capacity - 1);
+}
+
+TEST_F(PanicHookTest, SetAndTakeHook)
+{
+    EXPECT_EQ(panic::set_hook(&capture_hook), &capture_hook);
+    EXPECT_EQ(panic::take_hook(), &capture_hook);
+    EXPECT_EQ(panic::take_hook(), &panic::default_hook);
+}
+
+TEST_F(PanicHookTest, VoidValue)
+{
+    auto r1 = Result<Void, int>::Ok({});
+    EXPECT_THROW(r1.expect_err("expected a failure"), HookCalled);
+    EXPECT_EQ(last_panic.message, "expected a failure: ()");
+}
+
+TEST(ResultColdErrTest, ErrColdBuildsErr)
+{
+    auto r1 = Result<int, string>::ErrCold("cold");
+    EXPECT_TRUE(r1.is_err());
+    EXPECT_EQ(r1.unwrap_err(), "cold");
+
+    const string error = "cold copy";
+    auto r2 = Result<int, string>::ErrCold(error);
+    EXPECT_EQ(r2.unwrap_err(), "cold copy");
+}
@@ -0,0 +1,167 @@
+/**
+ * @file par_test.cpp
+ * @brief Unit tests for the parallel fail-fast algorithms
+ */
+
+#include "rstd++/par.hpp"
+#include "rstd++/result.hpp"
+
+#include <atomic>
+#include <gtest/gtest.h>
+#include <numeric>
+#include <stdexcept>
+#include <string>
+#include <vector>
+
+using namespace rstd;
+using namespace rstd::result;
+using std::string;
+
+namespace
+{
+
+auto iota(int n) -> std::vector<int>
+{
+    std::vector<int> v(static_cast<std::size_t>(n));
+    std::iota(v.begin(), v.end(), 0);
+    return v;
+}
+
+/**
+ * @brief Pool shared by the tests, larger than one thread even on small
+ *        machines
+ */
+auto pool() -> par::ThreadPool &
+{
+    static par::ThreadPool p(4);
+    return p;
+}
+
+} // namespace
+
+TEST(ThreadPoolTest, RunsOnEveryThread)
+{
+    std::atomic<int> calls = 0;
+    auto job = [&] { ++calls; };
+    pool().run(job);
+    EXPECT_EQ(calls.load(), 4);
+    EXPECT_EQ(pool().size(), 4u);
+
+    par::ThreadPool single(1);
+    single.run(job);
+    EXPECT_EQ(calls.load(), 5);
+}
+
+TEST(ThreadPoolTest, RethrowsExceptions)
+{
+    auto job = [] { throw std::runtime_error("boom"); };
+    EXPECT_THROW(pool().run(job), std::runtime_error);
+
+    // The pool is still usable afterwards
+    std::atomic<int> calls = 0;
+    auto count = [&] { ++calls; };
+    pool().run(count);
+    EXPECT_EQ(calls.load(), 4);
+}
+
+TEST(ParTest, TransformAllOk)
+{
+    const auto input = iota(10000);
+    auto r = par::try_transform(pool(), input, [](int v) {
+        return Result<long, string>::Ok(long{v} * 2);
+    });
+    ASSERT_TRUE(r.is_ok());
+    const auto &out = r.unwrap_unchecked();
+    ASSERT_EQ(out.size(), input.size());
+    for (std::size_t i = 0; i < out.size(); ++i) {
+        ASSERT_EQ(out[i], static_cast<long>(2 * i));
+    }
+
+    auto empty = par::try_transform(pool(), std::vector<int>{}, [](int v) {
+        return Result<int, string>::Ok(v);
+    });
+    EXPECT_TRUE(empty.unwrap_unchecked().empty());
+}
+
+TEST(ParTest, TransformToBool)
+{
+    // Neighbouring bools share a word in std::vector<bool>; every thread
+    // must still see its own writes land
+    const auto input = iota(10000);
+    for (int round = 0; round < 20; ++round) {
+        auto r = par::try_transform(pool(), input, [](int v) {
+            return Result<bool, int>::Ok(v % 3 == 0);
+        });
+        const auto &out = r.unwrap();
+        ASSERT_EQ(out.size(), input.size());
+        for (std::size_t i = 0; i < out.size(); ++i) {
+            ASSERT_EQ(out[i], i % 3 == 0);
+        }
+    }
+
+    auto failed = par::try_transform(pool(), input, [](int v) {
+        return v == 777 ? Result<bool, int>::Err(v)
+                        : Result<bool, int>::Ok(true);
+    });
+    ASSERT_TRUE(failed.is_err());
+    EXPECT_EQ(failed.unwrap_err_unchecked(), 777);
+}
+
+TEST(ParTest, LowestIndexErrorWins)
+{
+    const auto input = iota(20000);
+    for (int round = 0; round < 20; ++round) {
+        auto r = par::try_for_each(pool(), input, [](int v) {
+            if (v % 4999 == 4998) {
+                return Result<void, int>::Err(v);
+            }
+            return Result<void, int>::Ok();
+        });
+        ASSERT_EQ(r.unwrap_err(), 4998);
+    }
+}
+
+TEST(ParTest, CancelsRemainingWork)
+{
+    const auto input = iota(100000);
+    std::atomic<int> calls = 0;
+    auto r = par::try_transform(pool(), input, [&](int v) {
+        ++calls;
+        return v == 0 ? Result<int, string>::Err("first")
+                      : Result<int, string>::Ok(v);
+    });
+    EXPECT_TRUE(r.is_err());
+    EXPECT_LT(calls.load(), 100000 / 2);
+}
+
+TEST(ParTest, ReduceKeepsOrder)
+{
+    const auto input = iota(1000);
+    auto sum = par::try_reduce(
+        pool(), input, 0L, std::plus<>{},
+        [](int v) { return Result<long, string>::Ok(v); });
+    EXPECT_EQ(sum.unwrap(), 999L * 1000 / 2);
+
+    // Concatenation is associative but not commutative
+    auto text = par::try_reduce(
+        pool(), input, string("<"), std::plus<>{},
+        [](int v) { return Result<string, int>::Ok(std::to_string(v % 10)); });
+    string expected = "<";
+    for (int v : input) {
+        expected += std::to_string(v % 10);
+    }
+    EXPECT_EQ(text.unwrap(), expected);
+
+    auto failed = par::try_reduce(pool(), input, 0L, std::plus<>{}, [](int v) {
+        return v >= 500 ? Result<long, int>::Err(v) : Result<long, int>::Ok(v);
+    });
+    EXPECT_EQ(failed.unwrap_err(), 500);
+}
+
+TEST(ParTest, GlobalPool)
+{
+    auto r = par::try_transform(iota(100), [](int v) {
+        return Result<int, string>::Ok(v + 1);
+    });
+    EXPECT_EQ(r.unwrap_unchecked().back(), 100);
+}
@@ -0,0 +1,153 @@
+/**
+ * @file relocate_test.cpp
+ * @brief Unit tests for copyable Results, relocation and the relocate trait
+ */
+
+#include "rstd++/relocate.hpp"
+#include "rstd++/result.hpp"
+
+#include <cstddef>
+#include <gtest/gtest.h>
+#include <memory>
+#include <new>
+#include <string>
+#include <unordered_map>
+#include <vector>
+
+using namespace rstd;
+using namespace rstd::result;
+using std::string;
+
+namespace
+{
+
+using Boxed = Result<std::unique_ptr<int>, int>;
+
+/**
+ * @brief Points into itself, so it must not be moved with memcpy
+ */
+struct SelfRef
+{
+    int value;
+    int *self = &value;
+
+    explicit SelfRef(int v) : value{v} {}
+    SelfRef(SelfRef &&other) noexcept : value{other.value} {}
+};
+
+/**
+ * @brief Raw storage for @p N objects of T with no constructors run
+ */
+template <typename T, std::size_t N> struct Buffer
+{
+    alignas(T) std::byte bytes[N * sizeof(T)];
+
+    auto data() -> T * { return std::launder(reinterpret_cast<T *>(bytes)); }
+};
+
+} // namespace
+
+// ======================================================================
+// Special members
+// ======================================================================
+
+static_assert(std::is_copy_constructible_v<Result<string, int>>);
+static_assert(std::is_copy_assignable_v<Result<string, int>>);
+static_assert(!std::is_copy_constructible_v<Boxed>);
+static_assert(std::is_nothrow_move_constructible_v<Boxed>);
+static_assert(std::is_nothrow_move_assignable_v<Boxed>);
+static_assert(std::is_nothrow_move_constructible_v<Result<void, string>>);
+static_assert(std::is_trivially_copyable_v<Result<int, int>>);
+static_assert(std::is_trivially_copyable_v<Result<void, int>>);
+static_assert(std::is_trivially_copyable_v<Result<int &, int>>);
+static_assert(!std::is_nothrow_copy_constructible_v<Result<string, int>>);
+
+// ======================================================================
+// Trivial relocatability
+// ======================================================================
+
+static_assert(is_trivially_relocatable_v<int>);
+static_assert(is_trivially_relocatable_v<std::unique_ptr<int>>);
+static_assert(is_trivially_relocatable_v<std::shared_ptr<string>>);
+static_assert(!is_trivially_relocatable_v<SelfRef>);
+static_assert(is_trivially_relocatable_v<Boxed>);
+static_assert(is_trivially_relocatable_v<Result<void, std::unique_ptr<int>>>);
+static_assert(is_trivially_relocatable_v<Result<int &, int>>);
+static_assert(!is_trivially_relocatable_v<Result<SelfRef, int>>);
+static_assert(is_trivially_relocatable_v<Option<std::unique_ptr<int>>>);
+static_assert(!is_trivially_relocatable_v<Option<SelfRef>>);
+
+TEST(RelocateTest, CopiesAndMovesResults)
+{
+    auto ok = Result<string, int>::Ok("abc");
+    auto copy = ok;
+    EXPECT_EQ(copy.unwrap(), "abc");
+    EXPECT_EQ(ok.unwrap(), "abc");
+
+    auto err = Result<string, int>::Err(7);
+    copy = err;
+    EXPECT_EQ(copy.unwrap_err(), 7);
+
+    Result<string, int> moved = std::move(ok);
+    EXPECT_EQ(moved.unwrap(), "abc");
+
+    auto done = Result<void, string>::Err("gone");
+    auto again = done;
+    EXPECT_EQ(again.unwrap_err(), "gone");
+}
+
+TEST(RelocateTest, ResultsInContainers)
+{
+    std::vector<Boxed> results;
+    for (int i = 0; i < 100; ++i) {
+        results.push_back(i % 3 == 0 ? Boxed::Err(i)
+                                     : Boxed::Ok(std::make_unique<int>(i)));
+    }
+    for (int i = 0; i < 100; ++i) {
+        if (i % 3 == 0) {
+            EXPECT_EQ(results[i].unwrap_err_unchecked(), i);
+        } else {
+            EXPECT_EQ(*results[i].unwrap_unchecked(), i);
+        }
+    }
+
+    std::unordered_map<string, Result<int, string>> by_name;
+    by_name.emplace("one", Result<int, string>::Ok(1));
+    by_name.emplace("bad", Result<int, string>::Err("nope"));
+    EXPECT_EQ(by_name.at("one").unwrap(), 1);
+    EXPECT_EQ(by_name.at("bad").unwrap_err(), "nope");
+}
+
+TEST(RelocateTest, RelocatesByMemcpy)
+{
+    Buffer<Boxed, 4> from;
+    Buffer<Boxed, 4> to;
+    for (int i = 0; i < 4; ++i) {
+        if (i == 2) {
+            std::construct_at(from.data() + i, Boxed::Err(-1));
+        } else {
+            std::construct_at(from.data() + i,
+                              Boxed::Ok(std::make_unique<int>(i)));
+        }
+    }
+
+    Boxed *end = relocate(from.data(), from.data() + 4, to.data());
+    EXPECT_EQ(end, to.data() + 4);
+    EXPECT_EQ(*to.data()[3].unwrap_unchecked(), 3);
+    EXPECT_EQ(to.data()[2].unwrap_err_unchecked(), -1);
+    std::destroy(to.data(), end);
+}
+
+TEST(RelocateTest, RelocatesByMove)
+{
+    Buffer<SelfRef, 2> from;
+    Buffer<SelfRef, 2> to;
+    std::construct_at(from.data(), 1);
+    std::construct_at(from.data() + 1, 2);
+
+    SelfRef *end = relocate(from.data(), from.data() + 2, to.data());
+    EXPECT_EQ(end, to.data() + 2);
+    EXPECT_EQ(to.data()[1].value, 2);
+    EXPECT_EQ(to.data()[1].self, &to.data()[1].value);
+    std::destroy(to.data(), end);
+}
@@ -0,0 +1,172 @@
+/**
+ * @file result_borrow_test.cpp
+ * @brief Unit tests for borrowing accessors of Result
+ */
+
+#include "rstd++/result.hpp"
+
+#include <cstdlib>
+#include <gtest/gtest.h>
+#include <new>
+#include <stdexcept>
+#include <string>
+#include <vector>
+
+using namespace rstd::result;
+using std::string;
+
+namespace
+{
+
+// Per thread, so allocations on other threads neither race with nor
+// disturb the counts taken by a test
+thread_local std::size_t allocations = 0;
+
+/**
+ * @brief Counts the heap allocations this thread makes while it is alive
+ */
+class AllocationCounter
+{
+    std::size_t start_ = allocations;
+
+public:
+    [[nodiscard]] auto count() const -> std::size_t
+    {
+        return allocations - start_;
+    }
+};
+
+struct Row
+{
+    int id;
+    string name;
+
+    auto operator==(const Row &) const -> bool = default;
+};
+
+const string long_text(256, 'x');
+
+} // namespace
+
+// Not inlined, so GCC does not pair the free() below with a new-expression.
+[[gnu::noinline]] auto operator new(std::size_t n) -> void *
+{
+    ++allocations;
+    if (void *p = std::malloc(n == 0 ? 1 : n)) {
+        return p;
+    }
+    throw std::bad_alloc();
+}
+
+[[gnu::noinline]] auto operator delete(void *p) noexcept -> void
+{
+    std::free(p);
+}
+
+[[gnu::noinline]] auto operator delete(void *p, std::size_t) noexcept -> void
+{
+    std::free(p);
+}
+
+TEST(ResultBorrowTest, AsRefDoesNotCopy)
+{
+    auto r = Result<string, string>::Ok(long_text);
+    const AllocationCounter counter;
+
+    Result<const string &, const string &> borrowed = r.as_ref();
+    EXPECT_TRUE(borrowed.is_ok());
+    EXPECT_EQ(&borrowed.unwrap_unchecked(), &r.unwrap_unchecked());
+    EXPECT_EQ(borrowed.map([](const string &s) { return s.size(); }).unwrap(),
+              256u);
+    EXPECT_EQ(counter.count(), 0u);
+}
+
+TEST(ResultBorrowTest, AsRefOfErr)
+{
+    auto r = Result<int, string>::Err(long_text);
+    const AllocationCounter counter;
+
+    auto borrowed = r.as_ref();
+    EXPECT_TRUE(borrowed.is_err());
+    EXPECT_EQ(&borrowed.error(), &r.error());
+    EXPECT_EQ(counter.count(), 0u);
+}
+
+TEST(ResultBorrowTest, AsMutWritesThrough)
+{
+    auto r = Result<std::vector<Row>, string>::Ok({{1, long_text}});
+    const AllocationCounter counter;
+
+    r.as_mut().unwrap_unchecked()[0].id = 7;
+    r.value()[0].name.back() = 'y';
+    EXPECT_EQ(r.value()[0].id, 7);
+    EXPECT_EQ(r.value()[0].name.back(), 'y');
+    EXPECT_EQ(counter.count(), 0u);
+}
+
+TEST(ResultBorrowTest, ReferenceResultsAreOnePointerPlusTag)
+{
+    static_assert(sizeof(Result<const Row &, int>) <= 2 * sizeof(void *));
+    static_assert(std::is_trivially_copyable_v<Result<const Row &, int>>);
+    static_assert(std::is_trivially_destructible_v<Result<Row &, string &>>);
+}
+
+TEST(ResultBorrowTest, ValueAndErrorBorrow)
+{
+    const auto ok = Result<string, int>::Ok(long_text);
+    auto err = Result<string, string>::Err(long_text);
+    const AllocationCounter counter;
+
+    EXPECT_EQ(ok.value().size(), 256u);
+    EXPECT_EQ(err.error().size(), 256u);
+    err.error().clear();
+    EXPECT_TRUE(err.error().empty());
+    EXPECT_EQ(counter.count(), 0u);
+}
+
+TEST(ResultBorrowTest, ValueOfRvalueMoves)
+{
+    auto r = Result<string, int>::Ok(long_text);
+    auto e = Result<int, string>::Err(long_text);
+    const AllocationCounter counter;
+
+    string taken = std::move(r).value();
+    EXPECT_EQ(taken, long_text);
+    EXPECT_EQ(counter.count(), 0u);
+
+    string taken_err = std::move(e).unwrap_err_unchecked();
+    EXPECT_EQ(taken_err, long_text);
+    EXPECT_EQ(counter.count(), 0u);
+}
+
+TEST(ResultBorrowTest, WrongVariantPanics)
+{
+    auto ok = Result<int, string>::Ok(1);
+    auto err = Result<int, string>::Err("bad");
+
+    EXPECT_THROW((void)err.value(), std::runtime_error);
+    EXPECT_THROW((void)ok.error(), std::runtime_error);
+}
+
+TEST(ResultBorrowTest, UncheckedAfterCheck)
+{
+    const auto r = Result<Row, int>::Ok(Row{3, long_text});
+    const AllocationCounter counter;
+
+    if (r.is_ok()) {
+        const Row &row = r.unwrap_unchecked();
+        EXPECT_EQ(row.id, 3);
+    }
+    EXPECT_EQ(counter.count(), 0u);
+}
+
+TEST(ResultBorrowTest, ReferenceResultsCompareByValue)
+{
+    const Row a{1, "a"};
+    const Row b{1, "a"};
+    auto ra = Result<const Row &, int>::Ok(a);
+    auto rb = Result<const Row &, int>::Ok(b);
+
+    EXPECT_EQ(ra, rb);
+    EXPECT_EQ(&ra.unwrap(), &a);
+}
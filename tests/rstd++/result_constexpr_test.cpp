@@ -0,0 +1,177 @@
+/**
+ * @file result_constexpr_test.cpp
+ * @brief Compile-time tests for Result<T, E>
+ *
+ * Every check is a static_assert, so this file only has to compile; the
+ * TEST bodies re-check a few values at run time to register with gtest.
+ */
+
+#include "rstd++/core.hpp"
+#include "rstd++/result.hpp"
+
+#include <array>
+#include <gtest/gtest.h>
+#include <string>
+#include <string_view>
+
+using namespace rstd;
+using namespace rstd::result;
+
+namespace
+{
+
+constexpr auto checked_div(int a, int b) -> Result<int, const char *>
+{
+    if (b == 0) {
+        return Result<int, const char *>::Err("Division by zero");
+    }
+    return Result<int, const char *>::Ok(a / b);
+}
+
+constexpr auto parse_digit(char c) -> Result<int, char>
+{
+    if (c < '0' || c > '9') {
+        return Err<int, char>(c);
+    }
+    return Ok<int, char>(c - '0');
+}
+
+consteval auto parse_port(std::string_view s) -> Result<int, const char *>
+{
+    if (s.empty()) {
+        return Result<int, const char *>::Err("empty port");
+    }
+    int port = 0;
+    for (char c : s) {
+        auto digit = parse_digit(c);
+        if (digit.is_err()) {
+            return Result<int, const char *>::Err("not a number");
+        }
+        port = port * 10 + digit.unwrap();
+    }
+    if (port > 65535) {
+        return Result<int, const char *>::Err("port out of range");
+    }
+    return Result<int, const char *>::Ok(port);
+}
+
+struct Entry
+{
+    int code;
+    int weight;
+};
+
+consteval auto build_table() -> std::array<Entry, 4>
+{
+    std::array<Entry, 4> table{};
+    for (int i = 0; i < 4; ++i) {
+        table[static_cast<std::size_t>(i)] =
+            checked_div(100, i)
+                .map([i](int w) -> Entry { return {i, w}; })
+                .unwrap_or_default();
+    }
+    return table;
+}
+
+} // namespace
+
+// ======================================================================
+// Creation and queries
+// ======================================================================
+
+static_assert(Result<int, const char *>::Ok(1).is_ok());
+static_assert(Result<int, const char *>::Err("e").is_err());
+static_assert(Ok<int, Void>(3).unwrap() == 3);
+static_assert(Err<Void, int>(4).unwrap_err() == 4);
+static_assert(checked_div(10, 2).is_ok_and([](int v) { return v == 5; }));
+static_assert(checked_div(1, 0).is_err_and(
+    [](const char *e) { return std::string_view(e) == "Division by zero"; }));
+
+// ======================================================================
+// Adapters and extraction
+// ======================================================================
+
+static_assert(checked_div(9, 3).ok() == 3);
+static_assert(!checked_div(9, 0).ok().has_value());
+static_assert(checked_div(9, 0).err().has_value());
+static_assert(checked_div(8, 2).expect("constant") == 4);
+static_assert(checked_div(8, 0).unwrap_or_default() == 0);
+static_assert(std::string_view(checked_div(8, 0).expect_err("constant")) ==
+              "Division by zero");
+
+// ======================================================================
+// Combinators
+// ======================================================================
+
+static_assert(checked_div(20, 2).map([](int v) { return v * 2; }).unwrap() ==
+              20);
+static_assert(checked_div(20, 0).map_or(-1, [](int v) { return v; }) == -1);
+static_assert(checked_div(20, 4).map_or_else([](const char *) { return -1; },
+                                             [](int v) { return v; }) == 5);
+static_assert(checked_div(1, 0)
+                  .map_err([](const char *) { return 42; })
+                  .unwrap_err() == 42);
+static_assert(checked_div(100, 5)
+                  .and_then([](int v) { return checked_div(v, 2); })
+                  .unwrap() == 10);
+static_assert(checked_div(100, 0)
+                  .or_else([](const char *) { return checked_div(1, 1); })
+                  .unwrap() == 1);
+static_assert(checked_div(100, 0)
+                  .and_(Result<char, const char *>::Ok('x'))
+                  .is_err());
+static_assert(checked_div(100, 0).or_(checked_div(6, 3)).unwrap() == 2);
+static_assert(checked_div(3, 1).inspect([](int) {}).unwrap() == 3);
+
+// ======================================================================
+// Clone, assignment and comparison
+// ======================================================================
+
+static_assert([] {
+    const auto r = checked_div(6, 2);
+    return r.clone() == r;
+}());
+static_assert(checked_div(6, 2) != checked_div(6, 0));
+static_assert([] {
+    auto r = checked_div(6, 0);
+    const auto other = checked_div(6, 3);
+    r.clone_from(other);
+    return r.unwrap();
+}() == 2);
+static_assert([] {
+    auto r = checked_div(6, 3);
+    r.move_from(checked_div(6, 0));
+    return r.is_err();
+}());
+
+// Non-trivial payloads are constructed and destroyed at compile time too
+static_assert(Result<std::string, int>::Ok("constexpr")
+                  .map([](const std::string &s) { return s.size(); })
+                  .unwrap() == 9);
+static_assert([] {
+    auto r = Result<std::string, int>::Err(1);
+    const auto other = Result<std::string, int>::Ok("ok");
+    r.clone_from(other);
+    return r.unwrap() == "ok";
+}());
+
+// ======================================================================
+// consteval validation
+// ======================================================================
+
+static_assert(parse_port("8080").unwrap() == 8080);
+static_assert(std::string_view(parse_port("80a").unwrap_err()) ==
+              "not a number");
+static_assert(parse_port("99999").is_err());
+
+constexpr auto table = build_table();
+static_assert(table[0].weight == 0);
+static_assert(table[3].code == 3 && table[3].weight == 33);
+
+TEST(ResultConstexprTest, ValuesComputedAtCompileTime)
+{
+    constexpr auto port = parse_port("443").unwrap();
+    EXPECT_EQ(port, 443);
+    EXPECT_EQ(table[1].weight, 100);
+    EXPECT_EQ(table[2].weight, 50);
+}
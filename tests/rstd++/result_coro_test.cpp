@@ -0,0 +1,170 @@
+/**
+ * @file result_coro_test.cpp
+ * @brief Unit tests for Result coroutines
+ */
+
+#include "rstd++/result.hpp"
+#include "rstd++/result_coro.hpp"
+
+#include <gtest/gtest.h>
+#include <memory>
+#include <stdexcept>
+#include <string>
+
+using namespace rstd;
+using namespace rstd::result;
+using std::string;
+
+namespace
+{
+
+auto parse_digit(char c) -> Result<int, const char *>
+{
+    if (c < '0' || c > '9') {
+        return Result<int, const char *>::Err("not a digit");
+    }
+    return Result<int, const char *>::Ok(c - '0');
+}
+
+auto parse_two_digits(string s) -> Result<int, string>
+{
+    if (s.size() != 2) {
+        co_return Result<int, string>::Err("expected two characters");
+    }
+    int tens = co_await parse_digit(s[0]);
+    int ones = co_await parse_digit(s[1]);
+    co_return tens * 10 + ones;
+}
+
+auto sum_pairs(string a, string b) -> Result<int, string>
+{
+    int x = co_await parse_two_digits(a);
+    int y = co_await parse_two_digits(b);
+    co_return x + y;
+}
+
+// GCC 12 cannot tell that the Err temporary below is never destroyed as
+// an Ok: the frame escapes, so it reloads the discriminant after the string
+// is moved out and then follows the unique_ptr path through bytes that hold
+// the string's inline buffer. The storage only ever destroys the active
+// member, so the -Wfree-nonheap-object it reports for that path is spurious.
+#if defined(__GNUC__) && !defined(__clang__)
+#pragma GCC diagnostic push
+#pragma GCC diagnostic ignored "-Wfree-nonheap-object"
+#endif
+auto make_box(bool ok) -> Result<std::unique_ptr<int>, string>
+{
+    if (!ok) {
+        co_return Result<std::unique_ptr<int>, string>::Err("no box");
+    }
+    co_return std::make_unique<int>(5);
+}
+#if defined(__GNUC__) && !defined(__clang__)
+#pragma GCC diagnostic pop
+#endif
+
+auto unbox(bool ok) -> Result<int, string>
+{
+    std::unique_ptr<int> box = co_await make_box(ok);
+    co_return *box;
+}
+
+auto check_digits(string s) -> Result<void, string>
+{
+    for (char c : s) {
+        co_await parse_digit(c);
+    }
+}
+
+auto throwing() -> Result<int, string>
+{
+    int x = co_await parse_digit('1');
+    if (x == 1) {
+        throw std::logic_error("thrown from a Result coroutine");
+    }
+    co_return x;
+}
+
+} // namespace
+
+TEST(ResultCoroTest, OkValuesFlowThrough)
+{
+    auto r1 = parse_two_digits("42");
+    EXPECT_TRUE(r1.is_ok());
+    EXPECT_EQ(r1.unwrap(), 42);
+
+    auto r2 = sum_pairs("10", "32");
+    EXPECT_EQ(r2.unwrap(), 42);
+}
+
+TEST(ResultCoroTest, ErrShortCircuits)
+{
+    auto r1 = parse_two_digits("4x");
+    EXPECT_TRUE(r1.is_err());
+    EXPECT_EQ(r1.unwrap_err(), "not a digit");
+
+    auto r2 = parse_two_digits("123");
+    EXPECT_EQ(r2.unwrap_err(), "expected two characters");
+
+    auto r3 = sum_pairs("10", "3?");
+    EXPECT_EQ(r3.unwrap_err(), "not a digit");
+}
+
+TEST(ResultCoroTest, MoveOnlyPayloads)
+{
+    EXPECT_EQ(unbox(true).unwrap(), 5);
+    EXPECT_EQ(unbox(false).unwrap_err(), "no box");
+}
+
+TEST(ResultCoroTest, AwaitLvalueBorrows)
+{
+    auto source = Result<string, string>::Ok("kept");
+    auto length = [&source]() -> Result<std::size_t, string> {
+        const string &value = co_await source;
+        co_return value.size();
+    };
+
+    EXPECT_EQ(length().unwrap(), 4u);
+    EXPECT_EQ(source.unwrap(), "kept");
+}
+
+TEST(ResultCoroTest, VoidResults)
+{
+    EXPECT_TRUE(check_digits("123").is_ok());
+    EXPECT_EQ(check_digits("1a3").unwrap_err(), "not a digit");
+
+    auto counted = [](string s) -> Result<std::size_t, string> {
+        co_await check_digits(s);
+        co_return s.size();
+    };
+    EXPECT_EQ(counted("42").unwrap(), 2u);
+    EXPECT_TRUE(counted("4.2").is_err());
+}
+
+TEST(ResultCoroTest, ExceptionsPropagate)
+{
+    EXPECT_THROW({ auto r = throwing(); }, std::logic_error);
+    EXPECT_EQ(result::__detail::frame_arena::local().in_use(), 0u);
+}
+
+TEST(ResultCoroTest, FramesAreReleased)
+{
+    for (int i = 0; i < 1000; ++i) {
+        auto r = sum_pairs("12", "34");
+        EXPECT_EQ(r.unwrap(), 46);
+    }
+    EXPECT_EQ(result::__detail::frame_arena::local().in_use(), 0u);
+}
+
+TEST(ResultCoroTest, FramesReleasedOutOfOrderPanic)
+{
+    EXPECT_DEATH(
+        {
+            auto &arena = result::__detail::frame_arena::local();
+            void *outer = arena.allocate(64);
+            void *inner = arena.allocate(64);
+            arena.deallocate(outer, 64);
+            arena.deallocate(inner, 64);
+        },
+        "released out of order");
+}
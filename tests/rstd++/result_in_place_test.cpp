@@ -0,0 +1,187 @@
+/**
+ * @file result_in_place_test.cpp
+ * @brief Unit tests for in-place construction of Result payloads
+ */
+
+#include "rstd++/result.hpp"
+
+#include <array>
+#include <gtest/gtest.h>
+#include <mutex>
+#include <ostream>
+#include <stdexcept>
+#include <string>
+#include <utility>
+
+using namespace rstd;
+using namespace rstd::result;
+using std::string;
+
+namespace
+{
+
+/**
+ * @brief Counts how often instances are copied or moved
+ */
+struct Tracked
+{
+    static inline int copies = 0;
+    static inline int moves = 0;
+
+    std::array<int, 64> samples{};
+    string label;
+
+    Tracked(int first, string name) noexcept : label{std::move(name)}
+    {
+        samples[0] = first;
+    }
+
+    Tracked(const Tracked &other) : samples{other.samples}, label{other.label}
+    {
+        ++copies;
+    }
+
+    Tracked(Tracked &&other) noexcept
+        : samples{other.samples}, label{std::move(other.label)}
+    {
+        ++moves;
+    }
+
+    static auto reset() -> void
+    {
+        copies = 0;
+        moves = 0;
+    }
+};
+
+struct Pinned
+{
+    int code;
+
+    explicit Pinned(int c) noexcept : code{c} {}
+    Pinned(const Pinned &) = delete;
+    Pinned(Pinned &&) = delete;
+};
+
+struct Guarded
+{
+    std::mutex lock;
+    int value = 0;
+};
+
+struct ThrowsOnBuild
+{
+    explicit ThrowsOnBuild(bool fail)
+    {
+        if (fail) {
+            throw std::runtime_error("construction failed");
+        }
+    }
+};
+
+auto operator<<(std::ostream &os, const Tracked &t) -> std::ostream &
+{
+    return os << "Tracked(" << t.label << ")";
+}
+
+auto operator<<(std::ostream &os, const Pinned &p) -> std::ostream &
+{
+    return os << "Pinned(" << p.code << ")";
+}
+
+auto operator<<(std::ostream &os, const ThrowsOnBuild &) -> std::ostream &
+{
+    return os << "ThrowsOnBuild";
+}
+
+auto make_tracked(bool ok) -> Result<Tracked, Pinned>
+{
+    if (!ok) {
+        return Result<Tracked, Pinned>::Err(std::in_place, 404);
+    }
+    return Result<Tracked, Pinned>::Ok(std::in_place, 1, "built in place");
+}
+
+auto make_guarded() -> Result<Guarded, int>
+{
+    return Result<Guarded, int>::Ok(std::in_place);
+}
+
+constexpr auto constexpr_in_place() -> int
+{
+    auto r = Result<std::pair<int, int>, int>::Ok(std::in_place, 3, 4);
+    r.emplace_err(7);
+    r.emplace_ok(5, 6);
+    return r.unwrap().first + r.unwrap().second;
+}
+
+} // namespace
+
+static_assert(constexpr_in_place() == 11);
+
+TEST(ResultInPlaceTest, OkConstructsWithoutMoving)
+{
+    Tracked::reset();
+    auto r = make_tracked(true);
+    EXPECT_EQ(r.value().label, "built in place");
+    EXPECT_EQ(r.value().samples[0], 1);
+    EXPECT_EQ(Tracked::copies, 0);
+    EXPECT_EQ(Tracked::moves, 0);
+}
+
+TEST(ResultInPlaceTest, NonMovablePayloads)
+{
+    auto guarded = make_guarded();
+    {
+        const std::lock_guard<std::mutex> hold(guarded.value().lock);
+        guarded.value().value = 1;
+    }
+    EXPECT_EQ(guarded.value().value, 1);
+
+    auto err = make_tracked(false);
+    EXPECT_TRUE(err.is_err());
+    EXPECT_EQ(err.error().code, 404);
+}
+
+TEST(ResultInPlaceTest, EmplaceSwitchesVariant)
+{
+    Tracked::reset();
+    auto r = make_tracked(false);
+
+    Tracked &t = r.emplace_ok(2, string("second"));
+    EXPECT_TRUE(r.is_ok());
+    EXPECT_EQ(&t, &r.value());
+    EXPECT_EQ(t.label, "second");
+
+    Pinned &p = r.emplace_err(500);
+    EXPECT_TRUE(r.is_err());
+    EXPECT_EQ(p.code, 500);
+
+    r.emplace_err(501);
+    EXPECT_EQ(r.error().code, 501);
+    EXPECT_EQ(Tracked::copies, 0);
+    EXPECT_EQ(Tracked::moves, 0);
+}
+
+TEST(ResultInPlaceTest, EmplaceIsExceptionSafe)
+{
+    auto r = Result<ThrowsOnBuild, string>::Err("kept");
+    EXPECT_THROW(r.emplace_ok(true), std::runtime_error);
+    EXPECT_TRUE(r.is_err());
+    EXPECT_EQ(r.error(), "kept");
+
+    r.emplace_ok(false);
+    EXPECT_TRUE(r.is_ok());
+}
+
+TEST(ResultInPlaceTest, VoidResult)
+{
+    auto r = Result<void, Pinned>::Err(std::in_place, 1);
+    EXPECT_EQ(r.error().code, 1);
+
+    r.emplace_ok();
+    EXPECT_TRUE(r.is_ok());
+
+    r.emplace_err(2);
+    EXPECT_EQ(r.error().code, 2);
+}
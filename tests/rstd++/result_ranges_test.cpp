@@ -0,0 +1,176 @@
+/**
+ * @file result_ranges_test.cpp
+ * @brief Unit tests for the Result range adaptors and collect
+ */
+
+#include "rstd++/result.hpp"
+#include "rstd++/result_ranges.hpp"
+
+#include <gtest/gtest.h>
+#include <memory>
+#include <ranges>
+#include <set>
+#include <string>
+#include <vector>
+
+using namespace rstd;
+using namespace rstd::result;
+using std::string;
+
+namespace
+{
+
+int parse_calls = 0;
+
+auto parse_number(const string &s) -> Result<int, string>
+{
+    ++parse_calls;
+    if (s.empty() || s.find_first_not_of("0123456789") != string::npos) {
+        return Result<int, string>::Err("bad number: " + s);
+    }
+    return Result<int, string>::Ok(std::stoi(s));
+}
+
+/**
+ * @brief The error of @p r, which holds a container that cannot be printed
+ */
+template <typename T> auto error_of(const Result<T, string> &r) -> string
+{
+    return r.is_err() ? r.unwrap_err_unchecked() : "<ok>";
+}
+
+const std::vector<string> good = {"42", "123", "7"};
+const std::vector<string> mixed = {"42", "x", "123", "y", "7"};
+
+} // namespace
+
+static_assert(std::ranges::input_range<decltype(
+                  mixed | std::views::transform(parse_number) |
+                  views::ok_values)>);
+static_assert(!std::ranges::forward_range<decltype(
+                  mixed | std::views::transform(parse_number) |
+                  views::ok_values)>);
+
+TEST(ResultRangesTest, CollectAllOk)
+{
+    parse_calls = 0;
+    auto r =
+        good | std::views::transform(parse_number) | collect<std::vector>();
+    static_assert(
+        std::is_same_v<decltype(r), Result<std::vector<int>, string>>);
+    EXPECT_EQ(r.unwrap(), (std::vector<int>{42, 123, 7}));
+    EXPECT_EQ(parse_calls, 3);
+}
+
+TEST(ResultRangesTest, CollectStopsAtFirstErr)
+{
+    parse_calls = 0;
+    auto r = collect<std::vector>(mixed | std::views::transform(parse_number));
+    EXPECT_EQ(error_of(r), "bad number: x");
+    EXPECT_EQ(parse_calls, 2);
+}
+
+TEST(ResultRangesTest, CollectIntoOtherContainers)
+{
+    auto r = std::views::iota(0, 5) | std::views::transform([](int i) {
+                 return Result<int, string>::Ok(i % 3);
+             }) |
+             collect<std::set>();
+    EXPECT_EQ(r.unwrap(), (std::set<int>{0, 1, 2}));
+}
+
+TEST(ResultRangesTest, CollectMovesPayloads)
+{
+    auto r = std::views::iota(0, 3) | std::views::transform([](int i) {
+                 return Result<std::unique_ptr<int>, string>::Ok(
+                     std::make_unique<int>(i));
+             }) |
+             collect<std::vector>();
+    ASSERT_TRUE(r.is_ok());
+    EXPECT_EQ(*r.unwrap_unchecked()[2], 2);
+}
+
+TEST(ResultRangesTest, OkAndErrValues)
+{
+    parse_calls = 0;
+    std::vector<int> values;
+    for (int v : mixed | std::views::transform(parse_number) |
+                     views::ok_values) {
+        values.push_back(v);
+    }
+    EXPECT_EQ(values, (std::vector<int>{42, 123, 7}));
+    EXPECT_EQ(parse_calls, 5);
+
+    std::vector<string> errors;
+    for (string e : mixed | std::views::transform(parse_number) |
+                        views::err_values) {
+        errors.push_back(std::move(e));
+    }
+    EXPECT_EQ(errors, (std::vector<string>{"bad number: x", "bad number: y"}));
+}
+
+TEST(ResultRangesTest, OkValuesOfLvalueResults)
+{
+    Result<int, string> results[] = {
+        Result<int, string>::Ok(1),
+        Result<int, string>::Err("no"),
+        Result<int, string>::Ok(3),
+    };
+    auto oks = results | views::ok_values;
+    static_assert(std::ranges::forward_range<decltype(oks)>);
+    static_assert(std::is_same_v<std::ranges::range_reference_t<decltype(oks)>,
+                                 int &>);
+
+    for (int &v : oks) {
+        v *= 10;
+    }
+    EXPECT_EQ(results[0].unwrap(), 10);
+    EXPECT_EQ(results[2].unwrap(), 30);
+    EXPECT_EQ(std::ranges::distance(oks), 2);
+}
+
+TEST(ResultRangesTest, OkValuesCachesBegin)
+{
+    std::vector<Result<int, string>> results(
+        100, Result<int, string>::Err("no"));
+    results.push_back(Result<int, string>::Ok(5));
+
+    int reads = 0;
+    auto oks = results |
+               std::views::transform([&reads](auto &r) -> auto & {
+                   ++reads;
+                   return r;
+               }) |
+               views::ok_values;
+    static_assert(std::ranges::forward_range<decltype(oks)>);
+
+    EXPECT_EQ(*oks.begin(), 5);
+    const int first_scan = reads;
+    EXPECT_GE(first_scan, 101);
+    for (int i = 0; i < 10; ++i) {
+        EXPECT_EQ(*oks.begin(), 5);
+    }
+    EXPECT_EQ(reads, first_scan + 10);
+
+    // A copy scans again rather than reusing an iterator into the source
+    auto copy = oks;
+    EXPECT_EQ(*copy.begin(), 5);
+    EXPECT_GE(reads, first_scan + 10 + 101);
+}
+
+TEST(ResultRangesTest, TransformOkIsLazy)
+{
+    parse_calls = 0;
+    auto doubled_lazy = mixed | std::views::transform(parse_number) |
+                   views::transform_ok([](int v) { return v * 2; });
+    EXPECT_EQ(parse_calls, 0);
+
+    auto r = doubled_lazy | collect<std::vector>();
+    EXPECT_EQ(error_of(r), "bad number: x");
+    EXPECT_EQ(parse_calls, 2);
+
+    auto doubled = good | std::views::transform(parse_number) |
+                   views::transform_ok([](int v) { return v * 2; }) |
+                   collect<std::vector>();
+    EXPECT_EQ(doubled.unwrap(), (std::vector<int>{84, 246, 14}));
+}
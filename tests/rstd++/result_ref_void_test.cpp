@@ -0,0 +1,240 @@
+/**
+ * @file result_ref_void_test.cpp
+ * @brief Unit tests for Result<T &, E> and Result<void, E>
+ */
+
+#include "rstd++/result.hpp"
+#include "rstd++/try.hpp"
+
+#include <cstdint>
+#include <gtest/gtest.h>
+#include <map>
+#include <memory>
+#include <ostream>
+#include <string>
+
+using namespace rstd;
+using namespace rstd::result;
+using std::string;
+
+namespace
+{
+
+enum class LookupErr : std::int32_t
+{
+    Missing = 1,
+    Expired,
+};
+
+auto operator<<(std::ostream &os, LookupErr e) -> std::ostream &
+{
+    return os << "LookupErr(" << static_cast<std::int32_t>(e) << ")";
+}
+
+struct Entry
+{
+    int hits;
+    string payload;
+};
+
+} // namespace
+
+// Class types give their pointers a niche only on request
+template <>
+struct rstd::pointee_alignment<Entry>
+    : std::integral_constant<std::size_t, alignof(Entry)>
+{};
+
+namespace
+{
+
+auto operator<<(std::ostream &os, const Entry &e) -> std::ostream &
+{
+    return os << "Entry(" << e.hits << ", " << e.payload << ")";
+}
+
+class Cache
+{
+    std::map<int, Entry> entries_;
+
+public:
+    auto insert(int key, Entry entry) -> void
+    {
+        entries_.insert_or_assign(key, std::move(entry));
+    }
+
+    auto find(int key) const -> Result<const Entry &, LookupErr>
+    {
+        const auto it = entries_.find(key);
+        if (it == entries_.end()) {
+            return Result<const Entry &, LookupErr>::Err(LookupErr::Missing);
+        }
+        return Result<const Entry &, LookupErr>::Ok(it->second);
+    }
+
+    auto find_mut(int key) -> Result<Entry &, LookupErr>
+    {
+        const auto it = entries_.find(key);
+        if (it == entries_.end()) {
+            return Result<Entry &, LookupErr>::Err(LookupErr::Missing);
+        }
+        return Result<Entry &, LookupErr>::Ok(it->second);
+    }
+};
+
+auto validate_age(int age) -> Result<void, const char *>
+{
+    if (age < 0) {
+        return Result<void, const char *>::Err("Age cannot be negative");
+    }
+    return Result<void, const char *>::Ok();
+}
+
+auto checked_add(int a, int b) -> Result<int, const char *>
+{
+    RSTD_TRY_ASSIGN(auto ok_a, validate_age(a).map([a] { return a; }));
+    RSTD_TRY_ASSIGN(auto ok_b, validate_age(b).map([b] { return b; }));
+    return Result<int, const char *>::Ok(ok_a + ok_b);
+}
+
+} // namespace
+
+// Recording error call sites adds a field to every Result
+#if !RSTD_ERROR_LOCATIONS
+// A borrowed entry is a single pointer with the error in its spare bits
+static_assert(sizeof(Result<const Entry &, LookupErr>) == sizeof(Entry *));
+static_assert(sizeof(Result<Entry &, std::uint8_t>) == sizeof(Entry *));
+static_assert(std::is_trivially_copyable_v<Result<const Entry &, LookupErr>>);
+
+// Result<void, E> is as small as the error when E has a niche
+static_assert(sizeof(Result<void, std::unique_ptr<Entry>>) ==
+              sizeof(Entry *));
+static_assert(sizeof(Result<void, LookupErr>) ==
+              sizeof(Result<Void, LookupErr>));
+#endif
+static_assert(std::is_trivially_copyable_v<Result<void, LookupErr>>);
+
+TEST(ResultRefTest, LookupBorrowsEntry)
+{
+    Cache cache;
+    cache.insert(1, Entry{3, "one"});
+
+    auto found = cache.find(1);
+    EXPECT_TRUE(found.is_ok());
+    EXPECT_EQ(found.unwrap().payload, "one");
+    EXPECT_EQ(found.map([](const Entry &e) { return e.hits; }).unwrap(), 3);
+
+    auto missing = cache.find(2);
+    EXPECT_TRUE(missing.is_err());
+    EXPECT_EQ(missing.unwrap_err(), LookupErr::Missing);
+}
+
+TEST(ResultRefTest, MutableBorrowWritesThrough)
+{
+    Cache cache;
+    cache.insert(1, Entry{0, "one"});
+
+    cache.find_mut(1).unwrap().hits += 5;
+    EXPECT_EQ(cache.find(1).unwrap().hits, 5);
+    EXPECT_EQ(&cache.find(1).unwrap(), &cache.find_mut(1).unwrap());
+}
+
+TEST(ResultRefTest, AssignmentRebinds)
+{
+    Entry a{1, "a"};
+    Entry b{2, "b"};
+    auto r1 = Result<Entry &, LookupErr>::Ok(a);
+    const auto r2 = Result<Entry &, LookupErr>::Ok(b);
+
+    r1.clone_from(r2);
+    EXPECT_EQ(&r1.unwrap(), &b);
+    EXPECT_EQ(a.hits, 1);
+
+    const auto r3 = Result<Entry &, LookupErr>::Err(LookupErr::Expired);
+    r1.clone_from(r3);
+    EXPECT_EQ(r1.unwrap_err(), LookupErr::Expired);
+}
+
+TEST(ResultVoidTest, OkAndErr)
+{
+    auto r1 = validate_age(30);
+    EXPECT_TRUE(r1.is_ok());
+    r1.unwrap();
+
+    auto r2 = validate_age(-1);
+    EXPECT_TRUE(r2.is_err());
+    EXPECT_STREQ(r2.unwrap_err(), "Age cannot be negative");
+    EXPECT_THROW(r2.unwrap(), std::runtime_error);
+    EXPECT_THROW((void)r1.unwrap_err(), std::runtime_error);
+
+    auto r3 = Ok<void, int>();
+    auto r4 = Err<void, int>(4);
+    EXPECT_TRUE(r3.is_ok());
+    EXPECT_EQ(r4.unwrap_err(), 4);
+}
+
+TEST(ResultVoidTest, Combinators)
+{
+    auto ok = Result<void, string>::Ok();
+    auto err = Result<void, string>::Err("bad");
+
+    EXPECT_EQ(ok.map([] { return 7; }).unwrap(), 7);
+    EXPECT_EQ(err.map([] { return 7; }).unwrap_err(), "bad");
+    EXPECT_EQ(err.map_err([](const string &e) { return e.size(); })
+                  .unwrap_err(),
+              3u);
+    EXPECT_EQ(ok.map_or(0, [] { return 1; }), 1);
+    EXPECT_EQ(err.map_or(0, [] { return 1; }), 0);
+
+    int calls = 0;
+    (void)ok.inspect([&calls] { ++calls; });
+    (void)err.inspect([&calls] { ++calls; });
+    EXPECT_EQ(calls, 1);
+
+    auto chained =
+        ok.and_then([] { return Result<int, string>::Ok(1); }).unwrap();
+    EXPECT_EQ(chained, 1);
+    auto recovered = err.or_else(
+        [](const string &) { return Result<void, int>::Ok(); });
+    EXPECT_TRUE(recovered.is_ok());
+    const auto other_ok = Result<void, string>::Ok();
+    EXPECT_EQ(ok, other_ok);
+    EXPECT_NE(ok, err);
+}
+
+TEST(ResultVoidTest, MapToVoid)
+{
+    int seen = 0;
+    auto r = Result<int, string>::Ok(5).map([&seen](int v) { seen = v; });
+    static_assert(std::is_same_v<decltype(r), Result<void, string>>);
+    EXPECT_TRUE(r.is_ok());
+    EXPECT_EQ(seen, 5);
+}
+
+TEST(ResultVoidTest, BorrowError)
+{
+    auto err = Result<void, string>::Err("kept");
+    EXPECT_EQ(&err.as_ref().unwrap_err(), &err.error());
+    err.as_mut().unwrap_err() += "!";
+    EXPECT_EQ(err.error(), "kept!");
+}
+
+TEST(ResultVoidTest, TryPropagates)
+{
+    EXPECT_EQ(checked_add(1, 2).unwrap(), 3);
+    EXPECT_STREQ(checked_add(1, -2).unwrap_err(), "Age cannot be negative");
+}
+
+TEST(ResultVoidTest, NichePackedStateChanges)
+{
+    auto r = Result<void, std::unique_ptr<int>>::Ok();
+    EXPECT_TRUE(r.is_ok());
+
+    r.move_from(Result<void, std::unique_ptr<int>>::Err(
+        std::make_unique<int>(9)));
+    EXPECT_TRUE(r.is_err());
+    EXPECT_EQ(*r.error(), 9);
+
+    r.move_from(Result<void, std::unique_ptr<int>>::Ok());
+    EXPECT_TRUE(r.is_ok());
+}
@@ -0,0 +1,214 @@
+/**
+ * @file result_vec_test.cpp
+ * @brief Unit tests for the struct-of-arrays ResultVec
+ */
+
+#include "rstd++/result.hpp"
+#include "rstd++/result_vec.hpp"
+
+#include <cstdint>
+#include <gtest/gtest.h>
+#include <ostream>
+#include <ranges>
+#include <stdexcept>
+#include <string>
+#include <vector>
+
+using namespace rstd;
+using namespace rstd::result;
+using std::string;
+
+namespace
+{
+
+enum class ErrCode : std::int32_t
+{
+    Negative = 1,
+    TooLarge,
+};
+
+auto operator<<(std::ostream &os, ErrCode e) -> std::ostream &
+{
+    return os << "ErrCode(" << static_cast<std::int32_t>(e) << ")";
+}
+
+auto check(std::int32_t v) -> Result<std::int32_t, ErrCode>
+{
+    if (v < 0) {
+        return Result<std::int32_t, ErrCode>::Err(ErrCode::Negative);
+    }
+    if (v > 1000) {
+        return Result<std::int32_t, ErrCode>::Err(ErrCode::TooLarge);
+    }
+    return Result<std::int32_t, ErrCode>::Ok(v);
+}
+
+/**
+ * @brief 200 lanes: every 7th negative, every 50th too large
+ */
+auto sample() -> ResultVec<std::int32_t, ErrCode>
+{
+    return ResultVec<std::int32_t, ErrCode>(
+        std::views::iota(0, 200) | std::views::transform([](int i) {
+            return check(i % 50 == 49 ? 5000 : i % 7 == 3 ? -i : i);
+        }));
+}
+
+/**
+ * @brief Default construction throws while fail is set
+ */
+struct Fragile
+{
+    static inline bool fail = false;
+
+    Fragile()
+    {
+        if (fail) {
+            throw std::runtime_error("no placeholder");
+        }
+    }
+};
+
+} // namespace
+
+static_assert(!batch_value<bool>);
+static_assert(!batch_value<int &>);
+
+TEST(ResultVecTest, EmptyBatch)
+{
+    const ResultVec<int, ErrCode> v;
+    EXPECT_TRUE(v.empty());
+    EXPECT_EQ(v.count_ok(), 0u);
+    EXPECT_TRUE(v.all_ok());
+    EXPECT_FALSE(v.first_err().has_value());
+    EXPECT_TRUE(v.collect().unwrap().empty());
+}
+
+TEST(ResultVecTest, RoundTripsThroughResult)
+{
+    const auto v = sample();
+    ASSERT_EQ(v.size(), 200u);
+    EXPECT_EQ(v.ok_bits().size(), 4u);
+
+    for (std::size_t i = 0; i < v.size(); ++i) {
+        const auto expected = check(i % 50 == 49 ? 5000
+                                    : i % 7 == 3 ? -static_cast<int>(i)
+                                                 : static_cast<int>(i));
+        EXPECT_EQ(v.get(i), expected) << "lane " << i;
+        EXPECT_EQ(v.is_ok(i), expected.is_ok());
+    }
+    EXPECT_EQ(v.error(3), ErrCode::Negative);
+    EXPECT_EQ(v.error(49), ErrCode::TooLarge);
+}
+
+TEST(ResultVecTest, Queries)
+{
+    const auto v = sample();
+    // 29 lanes with i % 7 == 3 and four with i % 50 == 49; 199 is both
+    EXPECT_EQ(v.count_err(), 32u);
+    EXPECT_EQ(v.count_ok(), 200u - 32u);
+    EXPECT_FALSE(v.all_ok());
+    EXPECT_EQ(v.first_err(), 3u);
+    EXPECT_EQ(v.errors().size(), v.err_lanes().size());
+}
+
+TEST(ResultVecTest, MapRunsOverOkLanes)
+{
+    const auto v = sample();
+    const auto doubled = v.map([](std::int32_t x) { return 2 * x; });
+    for (std::size_t i = 0; i < v.size(); ++i) {
+        EXPECT_EQ(doubled.get(i), v.get(i).map([](int x) { return 2 * x; }));
+    }
+
+    auto names = sample().map(
+        [](std::int32_t x) { return std::to_string(x); });
+    static_assert(std::is_same_v<decltype(names), ResultVec<string, ErrCode>>);
+    EXPECT_EQ(names.get(11).unwrap(), "11");
+    EXPECT_EQ(names.get(3).unwrap_err(), ErrCode::Negative);
+}
+
+TEST(ResultVecTest, ErrorOfOkLanePanics)
+{
+    const auto v = sample();
+    EXPECT_EQ(v.error(3), ErrCode::Negative);
+    EXPECT_DEATH({ (void)v.error(4); }, "not Err");
+    EXPECT_DEATH({ (void)v.error(v.size()); }, "not Err");
+}
+
+TEST(ResultVecTest, MapSkipsErrLanes)
+{
+    // The first word is all Ok; the Err lanes after it hold a placeholder 0
+    // that the division must never see
+    ResultVec<std::int32_t, ErrCode> v;
+    for (std::int32_t i = 1; i <= 150; ++i) {
+        v.push_back(check(i > 64 && i % 5 == 0 ? -i : i));
+    }
+    std::size_t calls = 0;
+    const auto quotients = v.map([&calls](std::int32_t x) {
+        ++calls;
+        return 1000 / x;
+    });
+    EXPECT_EQ(calls, v.count_ok());
+    EXPECT_EQ(quotients.get(0).unwrap(), 1000);
+    EXPECT_EQ(quotients.get(63).unwrap(), 1000 / 64);
+    EXPECT_EQ(quotients.get(69).unwrap_err(), ErrCode::Negative);
+    EXPECT_EQ(quotients.get(148).unwrap(), 1000 / 149);
+    EXPECT_EQ(quotients.get(149).unwrap_err(), ErrCode::Negative);
+
+    ResultVec<string, ErrCode> words;
+    words.push_ok("alpha");
+    words.push_err(ErrCode::TooLarge);
+    words.push_ok("beta");
+    const auto initials =
+        std::move(words).map([](const string &s) { return s.at(0); });
+    EXPECT_EQ(initials.get(0).unwrap(), 'a');
+    EXPECT_EQ(initials.get(1).unwrap_err(), ErrCode::TooLarge);
+    EXPECT_EQ(initials.get(2).unwrap(), 'b');
+}
+
+TEST(ResultVecTest, FailedPushLeavesBatchUnchanged)
+{
+    ResultVec<Fragile, ErrCode> v;
+    v.push_ok(Fragile{});
+    v.push_err(ErrCode::Negative);
+
+    Fragile::fail = true;
+    EXPECT_THROW(v.push_err(ErrCode::TooLarge), std::runtime_error);
+    Fragile::fail = false;
+    EXPECT_EQ(v.size(), 2u);
+    EXPECT_EQ(v.count_ok(), 1u);
+    EXPECT_EQ(v.errors().size(), 1u);
+    EXPECT_EQ(v.err_lanes().size(), 1u);
+
+    v.push_err(ErrCode::TooLarge);
+    EXPECT_EQ(v.size(), 3u);
+    EXPECT_EQ(v.first_err(), 1u);
+    EXPECT_EQ(v.err_lanes().back(), 2u);
+    EXPECT_EQ(v.count_err(), 2u);
+}
+
+TEST(ResultVecTest, MapErr)
+{
+    const auto v = sample().map_err(
+        [](ErrCode e) { return static_cast<int>(e) * 100; });
+    static_assert(std::is_same_v<decltype(v), const ResultVec<int, int>>);
+    EXPECT_EQ(v.get(3).unwrap_err(), 100);
+    EXPECT_EQ(v.get(49).unwrap_err(), 200);
+    EXPECT_EQ(v.get(4).unwrap(), 4);
+}
+
+TEST(ResultVecTest, Collect)
+{
+    const auto failed = sample().collect();
+    ASSERT_TRUE(failed.is_err());
+    EXPECT_EQ(failed.unwrap_err_unchecked(), ErrCode::Negative);
+
+    ResultVec<int, ErrCode> ok;
+    for (int i = 0; i < 100; ++i) {
+        ok.push_back(check(i));
+    }
+    EXPECT_TRUE(ok.all_ok());
+    const auto values = std::move(ok).collect().unwrap();
+    ASSERT_EQ(values.size(), 100u);
+    EXPECT_EQ(values[99], 99);
+}
@@ -0,0 +1,367 @@
+/**
+ * @file task_test.cpp
+ * @brief Unit tests for Task coroutines and the EventLoop executor
+ */
+
+#include "rstd++/result.hpp"
+#include "rstd++/task.hpp"
+
+#include <coroutine>
+#include <cstdio>
+#include <gtest/gtest.h>
+#include <memory>
+#include <optional>
+#include <stdexcept>
+#include <string>
+#include <thread>
+#include <vector>
+
+using namespace rstd;
+using namespace rstd::result;
+using std::string;
+
+namespace
+{
+
+int resumed_after_await = 0;
+
+auto parse_digit(char c) -> Result<int, string>
+{
+    if (c < '0' || c > '9') {
+        return Result<int, string>::Err("not a digit");
+    }
+    return Result<int, string>::Ok(c - '0');
+}
+
+auto digit(char c) -> Task<int, string>
+{
+    int d = co_await parse_digit(c);
+    co_return d;
+}
+
+auto two_digits(string s) -> Task<int, string>
+{
+    int tens = co_await digit(s.at(0));
+    ++resumed_after_await;
+    int ones = co_await digit(s.at(1));
+    ++resumed_after_await;
+    co_return tens * 10 + ones;
+}
+
+auto sum(string a, string b) -> Task<int, string>
+{
+    int x = co_await two_digits(a);
+    ++resumed_after_await;
+    int y = co_await two_digits(b);
+    ++resumed_after_await;
+    co_return x + y;
+}
+
+auto countdown(int n) -> Task<int, string>
+{
+    if (n == 0) {
+        co_return 0;
+    }
+    int rest = co_await countdown(n - 1);
+    co_return rest + 1;
+}
+
+auto fail_at_bottom(int n) -> Task<int, string>
+{
+    if (n == 0) {
+        co_return Result<int, string>::Err("bottom");
+    }
+    int rest = co_await fail_at_bottom(n - 1);
+    ++resumed_after_await;
+    co_return rest + 1;
+}
+
+auto check(string s) -> Task<void, string>
+{
+    for (char c : s) {
+        co_await parse_digit(c);
+    }
+}
+
+auto throwing() -> Task<int, string>
+{
+    co_await digit('1');
+    throw std::logic_error("thrown from a task");
+}
+
+/**
+ * @brief Allocator counting the frames it hands out
+ */
+template <typename T> struct CountingAllocator
+{
+    using value_type = T;
+
+    int *live;
+
+    explicit CountingAllocator(int *counter) noexcept : live{counter} {}
+
+    template <typename U>
+    CountingAllocator(const CountingAllocator<U> &other) noexcept
+        : live{other.live}
+    {}
+
+    auto allocate(std::size_t n) -> T *
+    {
+        ++*live;
+        return std::allocator<T>{}.allocate(n);
+    }
+
+    auto deallocate(T *p, std::size_t n) noexcept -> void
+    {
+        --*live;
+        std::allocator<T>{}.deallocate(p, n);
+    }
+
+    auto operator==(const CountingAllocator &) const -> bool = default;
+};
+
+auto counted(std::allocator_arg_t, CountingAllocator<std::byte>, int v)
+    -> Task<int, string>
+{
+    int d = co_await digit('7');
+    co_return v + d;
+}
+
+/**
+ * @brief Panic hook that prints the message and returns, so the panic
+ *        aborts instead of throwing
+ */
+void print_panic(const panic::PanicInfo &info)
+{
+    std::fputs(info.message, stderr);
+}
+
+/**
+ * @brief Suspends on an awaitable that nothing ever resumes
+ */
+auto stalled() -> Task<int, string>
+{
+    co_await std::suspend_always{};
+    co_return 1;
+}
+
+/**
+ * @brief Runs a task from its destructor, at thread exit
+ */
+struct LateTask
+{
+    int *out;
+
+    ~LateTask()
+    {
+        EventLoop loop;
+        *out = loop.block_on(two_digits("57")).unwrap();
+    }
+};
+
+} // namespace
+
+TEST(TaskTest, OkValuesFlowThrough)
+{
+    EventLoop loop;
+    EXPECT_EQ(loop.block_on(two_digits("42")).unwrap(), 42);
+    EXPECT_EQ(loop.block_on(sum("10", "32")).unwrap(), 42);
+}
+
+TEST(TaskTest, StartsLazily)
+{
+    resumed_after_await = 0;
+    auto task = two_digits("12");
+    EXPECT_FALSE(task.done());
+    EXPECT_EQ(resumed_after_await, 0);
+
+    EventLoop loop;
+    EXPECT_EQ(loop.block_on(std::move(task)).unwrap(), 12);
+    EXPECT_EQ(resumed_after_await, 2);
+}
+
+TEST(TaskTest, ErrShortCircuits)
+{
+    EventLoop loop;
+    resumed_after_await = 0;
+    EXPECT_EQ(loop.block_on(sum("12", "3x")).unwrap_err(), "not a digit");
+    // sum resumed once after "12" and two_digits("3x") once after '3'
+    EXPECT_EQ(resumed_after_await, 3 + 1);
+
+    resumed_after_await = 0;
+    EXPECT_EQ(loop.block_on(fail_at_bottom(50)).unwrap_err(), "bottom");
+    EXPECT_EQ(resumed_after_await, 0);
+}
+
+TEST(TaskTest, DeepChains)
+{
+    EventLoop loop;
+    EXPECT_EQ(loop.block_on(countdown(10000)).unwrap(), 10000);
+    EXPECT_EQ(loop.block_on(fail_at_bottom(10000)).unwrap_err(), "bottom");
+}
+
+TEST(TaskTest, AsResultKeepsErrors)
+{
+    auto recover = [](string s) -> Task<int, string> {
+        auto r = co_await two_digits(s).as_result();
+        co_return r.is_ok() ? r.unwrap_unchecked() : -1;
+    };
+
+    EventLoop loop;
+    EXPECT_EQ(loop.block_on(recover("42")).unwrap(), 42);
+    EXPECT_EQ(loop.block_on(recover("4?")).unwrap(), -1);
+}
+
+TEST(TaskTest, ConvertsErrors)
+{
+    auto widen = []() -> Task<std::size_t, std::runtime_error> {
+        int v = co_await two_digits("?");
+        co_return static_cast<std::size_t>(v);
+    };
+
+    EventLoop loop;
+    auto r = loop.block_on(widen());
+    ASSERT_TRUE(r.is_err());
+    EXPECT_STREQ(r.unwrap_err_unchecked().what(), "not a digit");
+}
+
+TEST(TaskTest, VoidTasks)
+{
+    EventLoop loop;
+    EXPECT_TRUE(loop.block_on(check("123")).is_ok());
+    EXPECT_EQ(loop.block_on(check("1a3")).unwrap_err(), "not a digit");
+
+    auto length = [](string s) -> Task<std::size_t, string> {
+        co_await check(s);
+        co_return s.size();
+    };
+    EXPECT_EQ(loop.block_on(length("42")).unwrap(), 2u);
+    EXPECT_TRUE(loop.block_on(length("4.2")).is_err());
+}
+
+TEST(TaskTest, MoveOnlyPayloads)
+{
+    auto make = []() -> Task<std::unique_ptr<int>, string> {
+        co_return std::make_unique<int>(5);
+    };
+    auto unbox = [make]() -> Task<int, string> {
+        std::unique_ptr<int> box = co_await make();
+        co_return *box;
+    };
+
+    EventLoop loop;
+    EXPECT_EQ(loop.block_on(unbox()).unwrap(), 5);
+}
+
+TEST(TaskTest, ExceptionsPropagate)
+{
+    auto outer = []() -> Task<int, string> {
+        int v = co_await throwing();
+        co_return v;
+    };
+
+    EventLoop loop;
+    EXPECT_THROW({ auto r = loop.block_on(outer()); }, std::logic_error);
+}
+
+TEST(TaskTest, EventLoopInterleaves)
+{
+    EventLoop loop;
+    std::vector<string> trace;
+    auto worker = [&](string name) -> Task<int, string> {
+        for (int i = 0; i < 3; ++i) {
+            trace.push_back(name + std::to_string(i));
+            co_await loop.schedule();
+        }
+        co_return static_cast<int>(name.size());
+    };
+
+    auto a = worker("a");
+    auto b = worker("bb");
+    loop.spawn(a);
+    loop.spawn(b);
+    EXPECT_EQ(loop.run(), 8u);
+
+    ASSERT_TRUE(a.done());
+    ASSERT_TRUE(b.done());
+    EXPECT_EQ(std::move(a).result().unwrap(), 1);
+    EXPECT_EQ(std::move(b).result().unwrap(), 2);
+    EXPECT_EQ(trace, (std::vector<string>{"a0", "bb0", "a1", "bb1", "a2",
+                                          "bb2"}));
+}
+
+TEST(TaskTest, FramePoolReachesSteadyState)
+{
+    EventLoop loop;
+    EXPECT_EQ(loop.block_on(sum("12", "34")).unwrap(), 46);
+
+    const std::size_t warm = FramePool::local().heap_allocations();
+    for (int i = 0; i < 1000; ++i) {
+        EXPECT_EQ(loop.block_on(sum("12", "34")).unwrap(), 46);
+        EXPECT_EQ(loop.block_on(sum("12", "x4")).unwrap_err(), "not a digit");
+    }
+    EXPECT_EQ(FramePool::local().heap_allocations(), warm);
+}
+
+TEST(TaskTest, FramesOutliveThreadPool)
+{
+    // thread_locals are destroyed in reverse order of construction, so both
+    // of these outlive the pool, which is first used after them
+    int late = 0;
+    std::thread([&late] {
+        thread_local LateTask runner{&late};
+        thread_local std::optional<Task<int, string>> kept;
+        kept.emplace(digit('4'));
+        EXPECT_FALSE(FramePool::torn_down());
+    }).join();
+    EXPECT_EQ(late, 57);
+    EXPECT_FALSE(FramePool::torn_down());
+}
+
+TEST(TaskTest, UnfinishedTaskPanics)
+{
+    EXPECT_DEATH(
+        {
+            panic::set_hook(&print_panic);
+            EventLoop loop;
+            (void)loop.block_on(stalled());
+        },
+        "ran out of work");
+    EXPECT_DEATH(
+        {
+            panic::set_hook(&print_panic);
+            auto task = stalled();
+            (void)std::move(task).result();
+        },
+        "before the task finished");
+    EXPECT_DEATH(
+        {
+            panic::set_hook(&print_panic);
+            auto task = stalled();
+            auto moved = std::move(task);
+            (void)task.done();
+        },
+        "moved-from Task");
+}
+
+TEST(TaskTest, CustomFrameAllocator)
+{
+    int live = 0;
+    CountingAllocator<std::byte> alloc(&live);
+    {
+        auto task = counted(std::allocator_arg, alloc, 35);
+        EXPECT_EQ(live, 1);
+
+        EventLoop loop;
+        EXPECT_EQ(loop.block_on(std::move(task)).unwrap(), 42);
+    }
+    EXPECT_EQ(live, 0);
+
+    auto lambda = [](std::allocator_arg_t, CountingAllocator<std::byte>,
+                     int v) -> Task<int, string> { co_return v; };
+    {
+        auto task = lambda(std::allocator_arg, alloc, 3);
+        EXPECT_EQ(live, 1);
+    }
+    EXPECT_EQ(live, 0);
+}
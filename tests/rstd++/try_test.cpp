@@ -0,0 +1,131 @@
+/**
+ * @file try_test.cpp
+ * @brief Unit tests for the RSTD_TRY propagation macros
+ */
+
+#include "rstd++/core.hpp"
+#include "rstd++/result.hpp"
+#include "rstd++/try.hpp"
+
+#include <gtest/gtest.h>
+#include <memory>
+#include <string>
+
+using namespace rstd;
+using namespace rstd::result;
+using std::string;
+
+namespace
+{
+
+auto parse_digit(char c) -> Result<int, const char *>
+{
+    if (c < '0' || c > '9') {
+        return Result<int, const char *>::Err("not a digit");
+    }
+    return Result<int, const char *>::Ok(c - '0');
+}
+
+auto parse_two_digits(const string &s) -> Result<int, string>
+{
+    if (s.size() != 2) {
+        return Result<int, string>::Err("expected two characters");
+    }
+    int tens = RSTD_TRY(parse_digit(s[0]));
+    int ones = RSTD_TRY(parse_digit(s[1]));
+    return Result<int, string>::Ok(tens * 10 + ones);
+}
+
+auto parse_two_digits_portable(const string &s) -> Result<int, string>
+{
+    RSTD_TRY_ASSIGN(int tens, parse_digit(s.at(0)));
+    int ones = 0;
+    RSTD_TRY_ASSIGN(ones, parse_digit(s.at(1)));
+    return Result<int, string>::Ok(tens * 10 + ones);
+}
+
+auto make_box(bool ok) -> Result<std::unique_ptr<int>, string>
+{
+    if (!ok) {
+        return Result<std::unique_ptr<int>, string>::Err("no box");
+    }
+    return Result<std::unique_ptr<int>, string>::Ok(std::make_unique<int>(5));
+}
+
+auto unbox(bool ok) -> Result<int, string>
+{
+    std::unique_ptr<int> box = RSTD_TRY(make_box(ok));
+    return Result<int, string>::Ok(*box);
+}
+
+/**
+ * @brief A nested namespace named std must not capture the macro expansions
+ */
+namespace shadowed
+{
+
+namespace std
+{
+}
+
+auto sum_digits(const string &s) -> Result<int, string>
+{
+    int first = RSTD_TRY(parse_digit(s.at(0)));
+    RSTD_TRY_ASSIGN(int second, parse_digit(s.at(1)));
+    return Result<int, string>::Ok(first + second);
+}
+
+} // namespace shadowed
+
+} // namespace
+
+TEST(ResultTryTest, OkValuesFlowThrough)
+{
+    auto r1 = parse_two_digits("42");
+    EXPECT_TRUE(r1.is_ok());
+    EXPECT_EQ(r1.unwrap(), 42);
+
+    auto r2 = parse_two_digits_portable("07");
+    EXPECT_TRUE(r2.is_ok());
+    EXPECT_EQ(r2.unwrap(), 7);
+}
+
+TEST(ResultTryTest, ErrorIsConvertedAndReturned)
+{
+    auto r1 = parse_two_digits("4x");
+    EXPECT_TRUE(r1.is_err());
+    EXPECT_EQ(r1.unwrap_err(), "not a digit");
+
+    auto r2 = parse_two_digits("x4");
+    EXPECT_EQ(r2.unwrap_err(), "not a digit");
+
+    auto r3 = parse_two_digits_portable("?1");
+    EXPECT_EQ(r3.unwrap_err(), "not a digit");
+
+    auto r4 = parse_two_digits("123");
+    EXPECT_EQ(r4.unwrap_err(), "expected two characters");
+}
+
+TEST(ResultTryTest, MovesOnlyPayloads)
+{
+    EXPECT_EQ(unbox(true).unwrap(), 5);
+    EXPECT_EQ(unbox(false).unwrap_err(), "no box");
+}
+
+TEST(ResultTryTest, LvalueOperandIsNotMovedFrom)
+{
+    auto source = Result<string, string>::Err("kept");
+    auto forward = [&source]() -> Result<Void, string> {
+        auto value = RSTD_TRY(source);
+        return Result<Void, string>::Err(value);
+    };
+
+    EXPECT_EQ(forward().unwrap_err(), "kept");
+    EXPECT_EQ(source.unwrap_err(), "kept");
+}
+
+TEST(ResultTryTest, ExpandsInsideNamespaceShadowingStd)
+{
+    EXPECT_EQ(shadowed::sum_digits("34").unwrap(), 7);
+    EXPECT_EQ(shadowed::sum_digits("3x").unwrap_err(), "not a digit");
+}